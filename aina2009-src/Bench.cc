@@ -0,0 +1,157 @@
+/*
+ * Microbenchmarks for the simulator kernels: topology (lattice) generation,
+ * nearest MR lookups, event queue push/pop, clique and colouring schedulers
+ * and the local search. Sizes run from 10 to 10,000 routers or events and
+ * from 10 to 5,000 active links, and the scheduler times are per link.
+ * Results go to the screen and, as CSV, to the given file (see BenchHarness.h).
+ *
+ * usage: ./wmn-bench [csv file] [repetitions] [seconds per kernel and size]
+ */
+
+#include <iostream>       //std::cout
+#include <cstdlib>        //atoi, atof, srand48, drand48
+#include <cmath>          //sqrt
+#include <vector>         //std::vector
+
+#include "BenchHarness.h"
+#include "RouterTable.h"
+#include "Lattice.h"
+#include "Link.h"
+#include "Event.h"
+#include "EventQueue.h"
+#include "Matrix.h"
+#include "Coloring.h"
+#include "LocalSearch.h"
+#include "ScheduleBudget.h"
+
+#define RANGE 120
+#define CLIQUE_BUDGET 100000
+#define SEARCH_ITERATIONS 10000
+
+/*
+ * Side of the square area which holds about numRouters MRs on the lattice
+ */
+static double latticeSide(int numRouters)
+{
+  double perRow = sqrt((double)numRouters) - 2;
+  return perRow > 0 ? perRow * 0.75 * RANGE : 0;
+}
+
+/*
+ * The first numLinks links of a lattice, each needing 1 to 4 turns
+ */
+static std::vector <Link> activeLinks(int numLinks)
+{
+  RouterTable MR;
+  Lattice lattice;
+  lattice.generateHexagonal(latticeSide(numLinks / 2), latticeSide(numLinks / 2), RANGE, MR);
+  
+  std::vector <Link> LS;
+  for(unsigned int x=0;x<MR.size() && (int)LS.size()<numLinks;x++)
+    for(const int *n = lattice.neighboursBegin(x); n != lattice.neighboursEnd(x) && (int)LS.size()<numLinks; n++)
+    {
+      LS.push_back(Link(LS.size(), x, *n));
+      LS.back().setRequirement(1 + (int)(drand48() * 4));
+    }
+  return LS;
+}
+
+static long lengthOf(const std::vector <Clique> &scheduling)
+{
+  long links=0;
+  for(unsigned int c=0;c<scheduling.size();c++)
+    links = links + scheduling[c].size();
+  return links + scheduling.size();
+}
+
+int main(int argc, char *argv[])
+{
+  const char *csvPath = argc > 1 ? argv[1] : "bench.csv";
+  int reps = argc > 2 ? atoi(argv[2]) : 10;
+  double maxSeconds = argc > 3 ? atof(argv[3]) : 2.0;
+  BenchHarness bench(csvPath, reps, maxSeconds);
+  srand48(7);
+  
+  const int routerSizes[] = {10, 100, 1000, 10000};
+  const int linkSizes[] = {10, 100, 1000, 5000};
+  
+  for(unsigned int s=0;s<sizeof(routerSizes)/sizeof(routerSizes[0]);s++)
+  {
+    int size = routerSizes[s];
+    RouterTable MR;
+    Lattice lattice;
+    
+    bench.run("lattice", size, size, []{}, [&]{
+      lattice.generateHexagonal(latticeSide(size), latticeSide(size), RANGE, MR);
+      return (long)MR.size();
+    });
+    
+    std::vector <double> points(2000);
+    for(unsigned int p=0;p<points.size();p++)
+      points[p] = drand48() * latticeSide(size);
+    bench.run("nearest-router", size, points.size() / 2, []{}, [&]{
+      long found=0;
+      for(unsigned int p=0;p<points.size();p=p+2)
+        found = found + MR.nearest(points[p], points[p+1], RANGE);
+      return found;
+    });
+    
+    std::vector <double> times(size);
+    for(int e=0;e<size;e++)
+      times[e] = drand48() * 300;
+    for(int ticks=0;ticks<2;ticks++)
+    {
+      EventQueue EQ;
+      EQ.setResolution(ticks ? 1e9 : 0);
+      bench.run(ticks ? "event-queue-ticks" : "event-queue", size, 2 * size, [&]{EQ.clear();}, [&]{
+        for(int e=0;e<size;e++)
+          EQ.push(Event(times[e], e, e, 0));
+        long order=0;
+        while(!EQ.empty())
+        {
+          order = order + EQ.top().getSource();
+          EQ.pop();
+        }
+        return order;
+      });
+    }
+  }
+  
+  for(unsigned int s=0;s<sizeof(linkSizes)/sizeof(linkSizes[0]);s++)
+  {
+    int size = linkSizes[s];
+    std::vector <Link> LS = activeLinks(size);
+    
+    bench.run("compatibility", size, size, []{}, [&]{
+      Matrix CM(LS);
+      return (long)CM.getLowerBound();
+    });
+    
+    bench.run("clique-schedule", size, size, []{}, [&]{
+      Matrix CM(LS);
+      ScheduleBudget budget(CLIQUE_BUDGET, 0);
+      return lengthOf(CM.generateScheduling(budget));
+    });
+    
+    bench.run("dsatur", size, size, []{}, [&]{
+      Coloring engine(LS, true);
+      return lengthOf(engine.generateScheduling());
+    });
+    
+    bench.run("lrf", size, size, []{}, [&]{
+      Coloring engine(LS, false);
+      return lengthOf(engine.generateScheduling());
+    });
+    
+    Coloring seed(LS, true);
+    std::vector <Clique> initial = seed.generateScheduling();
+    std::vector <Clique> scheduling;
+    bench.run("local-search", size, size, [&]{scheduling = initial;}, [&]{
+      LocalSearch pass(LS);
+      return (long)pass.improve(scheduling, SEARCH_ITERATIONS);
+    });
+  }
+  
+  std::cout << "checksum: " << bench.getChecksum() << std::endl;
+  return 0;
+}
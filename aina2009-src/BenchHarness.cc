@@ -0,0 +1,50 @@
+#ifndef BENCHHARNESS_CC
+#define BENCHHARNESS_CC
+
+#include <iostream>       //std::cout
+#include <cstdlib>        //exit
+#include <cmath>          //sqrt
+
+#include "BenchHarness.h"
+
+BenchHarness::BenchHarness(const char *csvPath, int newReps, double newMaxSeconds)
+{
+  reps = newReps;
+  maxSeconds = newMaxSeconds;
+  checksum = 0;
+  
+  csv.open(csvPath);
+  if(!csv)
+  {
+    std::cout << "Error, could not open " << csvPath << " for writing" << std::endl;
+    exit(255);
+  }
+  csv << "kernel,size,reps,ops,mean_ns_per_op,stddev_ns_per_op,min_ns_per_op" << std::endl;
+}
+
+/*
+ * Writes the mean, sample standard deviation and minimum of the samples
+ * to the CSV file and the screen
+ */
+void BenchHarness::record(const char *kernelName, int size, long ops, const std::vector <double> &samples)
+{
+  double mean=0, min=samples[0];
+  for(unsigned int s=0;s<samples.size();s++)
+  {
+    mean = mean + samples[s];
+    if(samples[s] < min)
+      min = samples[s];
+  }
+  mean = mean / samples.size();
+  
+  double variance=0;
+  for(unsigned int s=0;s<samples.size();s++)
+    variance = variance + (samples[s] - mean) * (samples[s] - mean);
+  if(samples.size() > 1)
+    variance = variance / (samples.size() - 1);
+  
+  csv << kernelName << "," << size << "," << samples.size() << "," << ops << "," << mean << "," << sqrt(variance) << "," << min << std::endl;
+  std::cout << kernelName << "\tsize: " << size << "\treps: " << samples.size() << "\tns/op: " << mean << " +- " << sqrt(variance) << "\tmin: " << min << std::endl;
+}
+
+#endif
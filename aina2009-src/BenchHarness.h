@@ -0,0 +1,54 @@
+#ifndef BENCHHARNESS_H
+#define BENCHHARNESS_H
+
+#include <fstream>        //std::ofstream
+#include <vector>         //std::vector
+#include <chrono>         //std::chrono::steady_clock
+
+/*
+ * Times benchmark kernels and writes one CSV row per kernel and size:
+ *   kernel,size,reps,ops,mean_ns_per_op,stddev_ns_per_op,min_ns_per_op
+ * Each kernel is repeated up to the given number of times, stopping early
+ * (after at least two) once the time limit for that kernel and size is
+ * used up. Kernels return a checksum, which is summed so the compiler
+ * cannot optimise the work away.
+ */
+class BenchHarness
+{
+  public:
+  BenchHarness(const char *csvPath, int newReps, double newMaxSeconds);
+  
+  /*
+   * Runs setup() untimed and then kernel() timed for each repetition,
+   * kernel() doing ops operations
+   */
+  template <class Setup, class Kernel>
+  void run(const char *kernelName, int size, long ops, Setup setup, Kernel kernel)
+  {
+    std::vector <double> samples;
+    double total=0;
+    for(int r=0;r<reps && (r<2 || total<maxSeconds);r++)
+    {
+      setup();
+      std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+      checksum = checksum + kernel();
+      std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+      double seconds = std::chrono::duration<double>(t1 - t0).count();
+      total = total + seconds;
+      samples.push_back(seconds * 1e9 / (double)ops);
+    }
+    record(kernelName, size, ops, samples);
+  };
+  
+  long getChecksum() const {return checksum;};
+  
+  private:
+  void record(const char *kernelName, int size, long ops, const std::vector <double> &samples);
+  
+  std::ofstream csv;
+  int reps;
+  double maxSeconds;
+  long checksum;
+};
+
+#endif
@@ -8,7 +8,7 @@
  * Returns the Gain for the Clique
  * Gain = sum of all link costs - largest link cost
  */
-int Clique::getGain(std::vector <Link> linkdata)
+int Clique::getGain(const std::vector <Link> &linkdata) const
 {
   int gain=0;
   int largest=getWeight(linkdata);
@@ -26,7 +26,7 @@ int Clique::getGain(std::vector <Link> linkdata)
  * Returns the weight of a Clique
  * Weight = Maximal Requirement (may need to be revised)
  */
-int Clique::getWeight(std::vector <Link> linkdata)
+int Clique::getWeight(const std::vector <Link> &linkdata) const
 {
   int max=0;
   for(unsigned int c=0; c<LS.size(); c++)
@@ -43,7 +43,7 @@ int Clique::getWeight(std::vector <Link> linkdata)
 /*
  * Returns true if the two cliques are equivalent
  */
-bool Clique::equivalentClique(Clique c2)
+bool Clique::equivalentClique(const Clique &c2) const
 {
   /* Check for each link_id of c1 in c2 */
   for(unsigned int c=0; c< LS.size(); c++)
@@ -61,7 +61,7 @@ bool Clique::equivalentClique(Clique c2)
  * Checks if the given link_id already exists
  * within the clique
  */
-bool Clique::exists(int link_id)
+bool Clique::exists(int link_id) const
 {
   for(unsigned int l=0;l<LS.size();l++)
     if(LS[l] == link_id)
@@ -72,7 +72,7 @@ bool Clique::exists(int link_id)
 /*
  * Returns true if c1 and c2 intersect
  */
-bool Clique::intersect(Clique c2)
+bool Clique::intersect(const Clique &c2) const
 {
   for(unsigned int c=0;c<LS.size();c++)
     if(c2.exists(LS[c]))
@@ -88,7 +88,7 @@ bool Clique::intersect(Clique c2)
 /*
  * Returns a link_id from the clique
  */
-int Clique::getLink(unsigned int l)
+int Clique::getLink(unsigned int l) const
 {
   if(l > LS.size())
   {
@@ -108,7 +108,7 @@ void Clique::addLink(int link_id)
     LS.push_back(link_id);
 }
 
-void Clique::display()
+void Clique::display() const
 {
   for(unsigned int l=0; l < LS.size(); l++)
   {
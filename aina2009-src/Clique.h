@@ -10,21 +10,21 @@ class Clique
   public:
   
   /* Helper Functions */
-  bool equivalentClique(Clique c2);
-  bool exists(int link_id);
-  bool intersect(Clique c2);
+  bool equivalentClique(const Clique &c2) const;
+  bool exists(int link_id) const;
+  bool intersect(const Clique &c2) const;
   
   /* Accessors */
-  int getGain(std::vector<Link> linkdata);
-  int getWeight(std::vector<Link> linkdata);
-  unsigned int size(){return LS.size();};
-  int getLink(unsigned int l);
+  int getGain(const std::vector<Link> &linkdata) const;
+  int getWeight(const std::vector<Link> &linkdata) const;
+  unsigned int size() const {return LS.size();};
+  int getLink(unsigned int l) const;
   
   /* Mutators */
   void addLink(int link_id);
   
   /* Display Function */
-  void display();
+  void display() const;
   
   private:  
   std::vector<int> LS;
@@ -0,0 +1,147 @@
+#ifndef COLORING_CC
+#define COLORING_CC
+
+#include <set>            //std::set
+#include <tuple>          //std::tuple
+
+#include "Coloring.h"
+
+/*
+ * Construct a colouring scheduler over the links, using DSATUR order
+ * when dsatur is set and largest requirement first otherwise
+ */
+Coloring::Coloring(const std::vector <Link> &links, bool newDsatur) : LS(links)
+{
+  dsatur = newDsatur;
+}
+
+/*
+ * Returns the scheduling, one clique per colour
+ */
+std::vector <Clique> Coloring::generateScheduling()
+{
+  generateConflicts();
+  
+  /*
+   * Uncoloured links ordered by (saturation, requirement, degree), largest
+   * first and then by lowest id. Without DSATUR the saturation stays 0.
+   */
+  typedef std::tuple <int, int, int, int> Key;
+  std::set <Key> uncoloured;
+  std::vector <int> saturation(active.size(), 0);
+  for(unsigned int x=0;x<active.size();x++)
+    uncoloured.insert(Key(0, -LS[active[x]].getRequirement(), -(int)conflicts[x].size(), x));
+  
+  while(!uncoloured.empty())
+  {
+    int x = std::get<3>(*uncoloured.begin());
+    uncoloured.erase(uncoloured.begin());
+    
+    int c = pickColour(x);
+    colour(x, c);
+    
+    /* the conflicts which had not seen this colour yet become more saturated */
+    for(unsigned int n=0;n<conflicts[x].size();n++)
+    {
+      int y = conflicts[x][n];
+      if(colours[y] != -1)
+        continue;
+      bool taken = false;
+      for(unsigned int s=0;s<seen[y].size() && !taken;s++)
+        taken = seen[y][s] == c;
+      if(taken)
+        continue;
+      seen[y].push_back(c);
+      
+      if(dsatur)
+      {
+        Key old(-saturation[y], -LS[active[y]].getRequirement(), -(int)conflicts[y].size(), y);
+        uncoloured.erase(old);
+        saturation[y]++;
+        uncoloured.insert(Key(-saturation[y], -LS[active[y]].getRequirement(), -(int)conflicts[y].size(), y));
+      }
+    }
+  }
+  
+  std::vector <Clique> scheduling(weights.size());
+  for(unsigned int x=0;x<active.size();x++)
+    scheduling[colours[x]].addLink(active[x]);
+  return scheduling;
+}
+
+/* ---- Private Functions ---- */
+
+/*
+ * Collects the links with a requirement and, through the links at each MR,
+ * which of them conflict
+ */
+void Coloring::generateConflicts()
+{
+  active.clear();
+  std::vector < std::vector <int> > atRouter;
+  for(unsigned int l=0;l<LS.size();l++)
+  {
+    if(LS[l].getRequirement() <= 0)
+      continue;
+    int ends[2] = {LS[l].getSource(), LS[l].getDestination()};
+    for(int e=0;e<2;e++)
+    {
+      if(ends[e] >= (int)atRouter.size())
+        atRouter.resize(ends[e]+1);
+      atRouter[ends[e]].push_back(active.size());
+    }
+    active.push_back(l);
+  }
+  
+  conflicts.assign(active.size(), std::vector <int>());
+  for(unsigned int r=0;r<atRouter.size();r++)
+    for(unsigned int a=0;a<atRouter[r].size();a++)
+      for(unsigned int b=0;b<atRouter[r].size();b++)
+        if(a != b)
+          conflicts[atRouter[r][a]].push_back(atRouter[r][b]);
+  
+  seen.assign(active.size(), std::vector <int>());
+  colours.assign(active.size(), -1);
+  weights.clear();
+}
+
+/*
+ * Returns the colour which lengthens the frame least for the link, the
+ * lowest such colour on a tie, or a new colour if every one is taken
+ */
+int Coloring::pickColour(int x)
+{
+  int requirement = LS[active[x]].getRequirement();
+  std::vector <char> taken(weights.size(), false);
+  for(unsigned int s=0;s<seen[x].size();s++)
+    taken[seen[x][s]] = true;
+  
+  int best=-1; int bestIncrease=requirement;
+  for(unsigned int c=0;c<weights.size();c++)
+  {
+    if(taken[c])
+      continue;
+    int increase = requirement > weights[c] ? requirement - weights[c] : 0;
+    if(best == -1 || increase < bestIncrease)
+    {
+      best = c;
+      bestIncrease = increase;
+    }
+  }
+  
+  if(best == -1)
+  {
+    best = weights.size();
+    weights.push_back(0);
+  }
+  return best;
+}
+
+void Coloring::colour(int x, int c)
+{
+  colours[x] = c;
+  if(LS[active[x]].getRequirement() > weights[c])
+    weights[c] = LS[active[x]].getRequirement();
+}
+
+#endif
@@ -0,0 +1,39 @@
+#ifndef COLORING_H
+#define COLORING_H
+
+#include <vector>         //std::vector
+
+#include "Link.h"
+#include "Clique.h"
+
+/*
+ * Scheduler which builds the TDMA rounds by colouring the link conflict
+ * graph instead of enumerating cliques: every colour is one round, and a
+ * link joins the round where it lengthens the frame the least. Links are
+ * coloured in DSATUR order (most differently coloured conflicts first) or
+ * simply largest requirement first. Only links which share an MR conflict,
+ * so the graph comes from the links at each MR in near-linear time.
+ * It returns the same cliques as Matrix::generateScheduling.
+ */
+class Coloring
+{
+  public:
+  Coloring(const std::vector <Link> &links, bool dsatur);
+  std::vector <Clique> generateScheduling();
+  
+  private:
+  void generateConflicts();
+  int pickColour(int x);
+  void colour(int x, int c);
+  
+  const std::vector <Link> &LS;   //all the links (owned by the Simulation)
+  bool dsatur;
+  
+  std::vector <int> active;                 //ids of the links with a requirement
+  std::vector < std::vector <int> > conflicts;  //conflicting active links, by index into active
+  std::vector < std::vector <int> > seen;   //colours already taken by each link's conflicts
+  std::vector <int> colours;                //colour of each active link (-1 when uncoloured)
+  std::vector <int> weights;                //largest requirement in each colour
+};
+
+#endif
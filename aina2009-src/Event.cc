@@ -16,7 +16,7 @@
 /*
  * Display the event
  */
-void Event::display()
+void Event::display() const
 {
   std::cout << "  E: " << type << "\tS: " << source << "\tD: " << destination << "\t T: " << time << std::endl;
 }
@@ -21,17 +21,17 @@ class Event
   
   /* Accessors */
   double getTime() const {return time;}; 
-  double getDelay() {return cumulative_delay;};
-  int getSource(){return source;};
-  int getDestination(){return destination;};
-  int getType(){return type;};
+  double getDelay() const {return cumulative_delay;};
+  int getSource() const {return source;};
+  int getDestination() const {return destination;};
+  int getType() const {return type;};
   
   /* Mutators */
   void setType(int e_type){type=e_type;};
   void setDelay(double d){cumulative_delay=d;};
   
   /* Display */
-  void display();
+  void display() const;
   
   private:
   double time; double cumulative_delay;
@@ -0,0 +1,69 @@
+#ifndef EVENTPROFILE_CC
+#define EVENTPROFILE_CC
+
+#include "EventProfile.h"
+#include <iostream>       //std::cout
+
+static const char *eventNames[PROFILE_EVENT_TYPES] = {"NEW", "HOP", "DROP", "SUCCESS", "SCHEDULE", "PERMISSION_START", "PERMISSION_STOP"};
+
+EventProfile::EventProfile()
+{
+  reset();
+}
+
+/*
+ * Clears the counts and starts measuring the TSC rate again
+ */
+void EventProfile::reset()
+{
+  for(int type=0;type<PROFILE_EVENT_TYPES;type++)
+  {
+    counts[type] = 0;
+    totals[type] = 0;
+    for(int bucket=0;bucket<PROFILE_BUCKETS;bucket++)
+      histogram[type][bucket] = 0;
+  }
+  startTicks = ticks();
+  started = std::chrono::steady_clock::now();
+}
+
+/*
+ * Records one handled event of the given type which took the given ticks
+ */
+void EventProfile::add(int type, unsigned long long ticks)
+{
+  int bucket = 0;
+  while(bucket < PROFILE_BUCKETS-1 && (ticks >> bucket) > 1)
+    bucket++;
+  
+  counts[type]++;
+  totals[type] = totals[type] + ticks;
+  histogram[type][bucket]++;
+}
+
+/*
+ * Displays the count, total and mean handler time of every event type
+ * seen, followed by its histogram as upper bound in ns: count
+ */
+void EventProfile::display() const
+{
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+  unsigned long long elapsed = ticks() - startTicks;
+  double nsPerTick = (elapsed > 0) ? seconds * 1e9 / (double)elapsed : 0;
+  
+  std::cout << "Event Profile:" << std::endl;
+  for(int type=0;type<PROFILE_EVENT_TYPES;type++)
+  {
+    if(counts[type] == 0)
+      continue;
+    std::cout << "  " << eventNames[type] << "\tCount: " << counts[type] << "\tTotal: " << totals[type] * nsPerTick / 1e6 << "ms"
+              << "\tMean: " << totals[type] * nsPerTick / (double)counts[type] << "ns" << std::endl;
+    std::cout << "   ";
+    for(int bucket=0;bucket<PROFILE_BUCKETS;bucket++)
+      if(histogram[type][bucket] > 0)
+        std::cout << " <" << (long long)((double)(2ULL << bucket) * nsPerTick) << "ns: " << histogram[type][bucket];
+    std::cout << std::endl;
+  }
+}
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef EVENTPROFILE_H
+#define EVENTPROFILE_H
+
+#include <chrono>         //std::chrono::steady_clock
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>    //__rdtsc
+#endif
+
+#define PROFILE_EVENT_TYPES 7     //NEW to PERMISSION_STOP, see Simulation.h
+#define PROFILE_BUCKETS 48        //handler times up to 2^48 ticks
+
+/*
+ * Per event type counts, handler times and a histogram of the handler
+ * times in power of two buckets, filled by the ProfileTrace policy (see
+ * Policies.h). Times are read from the TSC where there is one and are
+ * converted to ns when displayed, using the TSC rate seen since reset().
+ */
+class EventProfile
+{
+  public:
+  EventProfile();
+  
+  void reset();
+  void add(int type, unsigned long long ticks);
+  void display() const;
+  
+  /* the current tick count, cheap enough to read around every event */
+  static unsigned long long ticks()
+  {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+  };
+  
+  private:
+  long counts[PROFILE_EVENT_TYPES];
+  unsigned long long totals[PROFILE_EVENT_TYPES];
+  long histogram[PROFILE_EVENT_TYPES][PROFILE_BUCKETS];
+  
+  unsigned long long startTicks;
+  std::chrono::steady_clock::time_point started;
+};
+
+#endif
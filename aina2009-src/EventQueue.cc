@@ -0,0 +1,181 @@
+#ifndef EVENTQUEUE_CC
+#define EVENTQUEUE_CC
+
+#include "EventQueue.h"
+#include <algorithm>      //std::push_heap, std::pop_heap
+#include <cmath>          //llround
+#include <cstdlib>        //exit
+
+/*
+ * Returns a copy of the earliest event
+ */
+Event EventQueue::top()
+{
+  if(ticksPerSecond == 0)
+  {
+    const Entry &entry = heap.front();
+    return makeEvent(entry.time, entry.type, entry.payload);
+  }
+  
+  refill();
+  const TickEntry &entry = buckets[0][front];
+  return makeEvent((double)entry.tick / ticksPerSecond, entry.type, entry.payload);
+}
+
+/*
+ * Switches between double times (ticks = 0) and integer ticks with the
+ * given number of ticks per second. Only allowed while the queue is empty.
+ */
+void EventQueue::setResolution(double ticks)
+{
+  if(count != 0)
+  {
+    std::cout << "Error, the event queue resolution can only be changed while it is empty" << std::endl;
+    exit(255);
+  }
+  ticksPerSecond = ticks;
+  clear();
+}
+
+/*
+ * Adds an event, reusing a free payload record if there is one
+ */
+void EventQueue::push(const Event &E)
+{
+  unsigned int index = newPayload(E);
+  count++;
+  
+  if(ticksPerSecond == 0)
+  {
+    Entry entry;
+    entry.time = E.getTime();
+    entry.payload = index;
+    entry.type = E.getType();
+    heap.push_back(entry);
+    std::push_heap(heap.begin(), heap.end(), Later());
+    return;
+  }
+  
+  /* 
+   * events are never scheduled before the current time, but rounding
+   * could put one a tick early, so keep the keys monotone
+   */
+  TickEntry entry;
+  long long tick = llround(E.getTime() * ticksPerSecond);
+  entry.tick = tick < (long long)last ? last : (unsigned long long)tick;
+  entry.payload = index;
+  entry.type = E.getType();
+  buckets[bucketOf(entry.tick)].push_back(entry);
+}
+
+/*
+ * Removes the earliest event and frees its payload record
+ */
+void EventQueue::pop()
+{
+  count--;
+  
+  if(ticksPerSecond == 0)
+  {
+    freePayloads.push_back(heap.front().payload);
+    std::pop_heap(heap.begin(), heap.end(), Later());
+    heap.pop_back();
+    return;
+  }
+  
+  refill();
+  freePayloads.push_back(buckets[0][front].payload);
+  front++;
+  if(front == buckets[0].size())
+  {
+    buckets[0].clear();
+    front = 0;
+  }
+}
+
+/*
+ * Removes every event but keeps the memory for reuse
+ */
+void EventQueue::clear()
+{
+  heap.clear();
+  for(int b=0; b<65; b++)
+    buckets[b].clear();
+  last = 0;
+  front = 0;
+  count = 0;
+  payloads.clear();
+  freePayloads.clear();
+}
+
+/* ---- Private Functions ---- */
+
+unsigned int EventQueue::newPayload(const Event &E)
+{
+  unsigned int index;
+  if(freePayloads.empty())
+  {
+    index = payloads.size();
+    payloads.push_back(Payload());
+  }
+  else
+  {
+    index = freePayloads.back();
+    freePayloads.pop_back();
+  }
+  
+  Payload &payload = payloads[index];
+  payload.delay = E.getDelay();
+  payload.source = E.getSource();
+  payload.destination = E.getDestination();
+  return index;
+}
+
+Event EventQueue::makeEvent(double time, int type, unsigned int payload) const
+{
+  const Payload &p = payloads[payload];
+  Event E(time, p.source, p.destination, type);
+  E.setDelay(p.delay);
+  return E;
+}
+
+/*
+ * Bucket 0 holds ticks equal to last, otherwise one more than the index
+ * of the highest bit where the tick differs from last
+ */
+int EventQueue::bucketOf(unsigned long long tick) const
+{
+  if(tick == last)
+    return 0;
+  return 64 - __builtin_clzll(tick ^ last);
+}
+
+/*
+ * Makes sure buckets[0] holds the earliest events. If it has run out,
+ * the first non-empty bucket is split around its smallest tick, which
+ * becomes the new last; every entry in it lands in a lower bucket.
+ * Entries keep their relative order, so equal ticks stay first in,
+ * first out.
+ */
+void EventQueue::refill()
+{
+  if(!buckets[0].empty())
+    return;
+  
+  int b = 1;
+  while(buckets[b].empty())
+    b++;
+  
+  std::vector<TickEntry> &bucket = buckets[b];
+  unsigned long long minimum = bucket[0].tick;
+  for(unsigned int e=1; e<bucket.size(); e++)
+    if(bucket[e].tick < minimum)
+      minimum = bucket[e].tick;
+  
+  last = minimum;
+  for(unsigned int e=0; e<bucket.size(); e++)
+    buckets[bucketOf(bucket[e].tick)].push_back(bucket[e]);
+  bucket.clear();
+}
+
+#endif
@@ -0,0 +1,88 @@
+#ifndef EVENTQUEUE_H
+#define EVENTQUEUE_H
+
+#include <vector>         //std::vector
+
+#include "Event.h"
+
+/*
+ * Priority queue of Events ordered by time (earliest on top).
+ * 
+ * The heap only holds a 16 byte entry per event: the time key, the event
+ * type and the index of a payload record (source, destination and
+ * cumulative delay) kept in a side table. Heap comparisons and moves
+ * therefore stay within one cache line, and payload records are recycled
+ * through a free list instead of being reallocated.
+ * 
+ * With a tick resolution set, event times are rounded to whole ticks as
+ * they are pushed and the events are kept in a radix heap instead of the
+ * binary heap. Since simulation time never goes backwards, the radix heap
+ * only ever compares integer keys against the last one popped, and events
+ * at the same tick come out in the order they were pushed.
+ */
+class EventQueue
+{
+  public:
+  /* Constructors */
+  EventQueue(){ticksPerSecond=0; count=0; last=0; front=0;};
+  
+  /* Accessors */
+  bool empty() const {return count == 0;};
+  unsigned int size() const {return count;};
+  double getResolution() const {return ticksPerSecond;};
+  Event top();
+  
+  /* Mutators */
+  void setResolution(double ticks);
+  void push(const Event &E);
+  void pop();
+  void clear();
+  
+  private:
+  struct Entry
+  {
+    double time;
+    unsigned int payload;
+    int type;
+  };
+  
+  struct TickEntry
+  {
+    unsigned long long tick;
+    unsigned int payload;
+    int type;
+  };
+  
+  struct Payload
+  {
+    double delay;
+    int source, destination;
+  };
+  
+  /* (note a > b causes lowest times to be on top of the heap) */
+  struct Later
+  {
+    bool operator()(const Entry &a, const Entry &b) const {return a.time > b.time;};
+  };
+  
+  unsigned int newPayload(const Event &E);
+  Event makeEvent(double time, int type, unsigned int payload) const;
+  int bucketOf(unsigned long long tick) const;
+  void refill();
+  
+  double ticksPerSecond;          //0 for double times and the binary heap
+  unsigned int count;
+  
+  /* binary heap (double times) */
+  std::vector<Entry> heap;
+  
+  /* radix heap (tick times): bucket b > 0 holds ticks whose highest bit differing from last is b-1 */
+  std::vector<TickEntry> buckets[65];
+  unsigned long long last;        //tick of the last event popped
+  unsigned int front;             //next entry of buckets[0] to pop
+  
+  std::vector<Payload> payloads;
+  std::vector<unsigned int> freePayloads;
+};
+
+#endif
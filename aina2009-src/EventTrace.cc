@@ -0,0 +1,184 @@
+#ifndef EVENTTRACE_CC
+#define EVENTTRACE_CC
+
+#include "EventTrace.h"
+#include <iostream>       //std::cout
+#include <cstdio>         //FILE, fopen, fwrite
+#include <cstdlib>        //atexit, exit
+#include <cstring>        //memcpy
+#include <vector>         //std::vector
+#include <mutex>          //std::mutex
+#include <condition_variable>   //std::condition_variable
+#include <thread>         //std::thread
+
+static_assert(sizeof(TraceRecord) == 32, "TraceRecord must have no padding");
+
+std::atomic<bool> EventTrace::active(false);
+
+struct TraceBuffer
+{
+  TraceRecord records[EVENT_TRACE_RECORDS];
+  int count;
+};
+
+/*
+ * The full buffers waiting for the flush thread, in the order they were
+ * handed over, and the written ones kept for reuse
+ */
+static std::mutex traceLock;
+static std::condition_variable traceReady;
+static std::vector<TraceBuffer *> fullBuffers, spareBuffers;
+static bool stopping = false;
+static FILE *traceFile = NULL;
+static std::thread flusher;
+static std::atomic<int> runs(0);
+
+static void handOff(TraceBuffer *buffer)
+{
+  std::lock_guard<std::mutex> lock(traceLock);
+  if(traceFile == NULL)
+  {
+    delete buffer;
+    return;
+  }
+  fullBuffers.push_back(buffer);
+  traceReady.notify_one();
+}
+
+static TraceBuffer *takeSpare()
+{
+  TraceBuffer *buffer = NULL;
+  {
+    std::lock_guard<std::mutex> lock(traceLock);
+    if(!spareBuffers.empty())
+    {
+      buffer = spareBuffers.back();
+      spareBuffers.pop_back();
+    }
+  }
+  if(buffer == NULL)
+    buffer = new TraceBuffer;
+  buffer->count = 0;
+  return buffer;
+}
+
+/* The calling thread's buffer, handed over when the thread ends */
+struct LocalTraceBuffer
+{
+  TraceBuffer *buffer;
+  LocalTraceBuffer() : buffer(NULL) {};
+  ~LocalTraceBuffer() {if(buffer != NULL) handOff(buffer); buffer = NULL;};
+};
+
+static thread_local LocalTraceBuffer local;
+
+/*
+ * Writes the full buffers as they arrive, until close()
+ */
+static void flush()
+{
+  std::vector<TraceBuffer *> writing;
+  std::unique_lock<std::mutex> lock(traceLock);
+  while(true)
+  {
+    traceReady.wait(lock, []{return !fullBuffers.empty() || stopping;});
+    if(fullBuffers.empty())
+      break;
+    writing.swap(fullBuffers);
+
+    lock.unlock();
+    for(unsigned int b=0;b<writing.size();b++)
+      fwrite(writing[b]->records, sizeof(TraceRecord), writing[b]->count, traceFile);
+    lock.lock();
+
+    spareBuffers.insert(spareBuffers.end(), writing.begin(), writing.end());
+    writing.clear();
+  }
+}
+
+/*
+ * Starts recording to path. Later calls keep the first file, so every
+ * scenario of a sweep goes into one trace, told apart by the runs.
+ */
+void EventTrace::open(const std::string &path)
+{
+  if(active.load())
+    return;
+
+  traceFile = fopen(path.c_str(), "wb");
+  if(traceFile == NULL)
+  {
+    std::cout << "Error, could not write the event trace " << path << std::endl;
+    exit(255);
+  }
+  TraceHeader header;
+  memcpy(header.magic, EVENT_TRACE_MAGIC, sizeof(header.magic));
+  header.version = EVENT_TRACE_VERSION;
+  header.recordSize = sizeof(TraceRecord);
+  fwrite(&header, sizeof(header), 1, traceFile);
+
+  flusher = std::thread(flush);
+  active.store(true);
+  atexit(close);
+}
+
+/*
+ * Returns the number of a new run, for its records
+ */
+int EventTrace::beginRun()
+{
+  int run = runs++;
+  if(run >= EVENT_TRACE_RUNS)
+  {
+    std::cout << "Error, the event trace can only tell " << EVENT_TRACE_RUNS << " runs apart" << std::endl;
+    exit(255);
+  }
+  return run;
+}
+
+void EventTrace::record(int run, int type, double time, int source, int destination, int packet, double delay)
+{
+  TraceBuffer *buffer = local.buffer;
+  if(buffer == NULL)
+    buffer = local.buffer = takeSpare();
+
+  TraceRecord &r = buffer->records[buffer->count++];
+  r.time = time;
+  r.delay = delay;
+  r.source = source;
+  r.destination = destination;
+  r.packet = packet;
+  r.event = ((unsigned int)run << 8) | ((unsigned int)type & 0xff);
+
+  if(buffer->count == EVENT_TRACE_RECORDS)
+  {
+    handOff(buffer);
+    local.buffer = NULL;
+  }
+}
+
+/*
+ * Writes everything handed over and closes the file, at exit. By then
+ * every thread, the main one included, has handed over its last buffer.
+ */
+void EventTrace::close()
+{
+  if(!active.exchange(false))
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(traceLock);
+    stopping = true;
+    traceReady.notify_one();
+  }
+  flusher.join();
+
+  std::lock_guard<std::mutex> lock(traceLock);
+  fclose(traceFile);
+  traceFile = NULL;
+  for(unsigned int b=0;b<spareBuffers.size();b++)
+    delete spareBuffers[b];
+  spareBuffers.clear();
+}
+
+#endif
@@ -0,0 +1,107 @@
+#ifndef LATTICE_CC
+#define LATTICE_CC
+
+#include "Lattice.h"
+#include <cmath>
+
+/*
+ * Places MRs on rows spaced 3/4 of the range apart, every second row
+ * shifted by half a spacing, covering maxX by maxY. Any existing MRs
+ * are replaced.
+ */
+void Lattice::generateHexagonal(double maxX, double maxY, double range, RouterTable &MR)
+{
+  double x=0, y=0;
+  bool indentRow = true;
+  int currentID=0;
+  
+  /* calculate the distances in x and y direction that MRs will be spread apart */
+  double xDist = (double)3/4 * range;
+  double yDist = xDist;
+  
+  /* reserve the whole lattice up front so large meshes don't reallocate */
+  int numRows = (int)ceil((maxY + yDist) / yDist) + 1;
+  int numCols = (int)ceil((maxX + xDist) / xDist) + 1;
+  MR.clear();
+  MR.reserve((size_t)numRows * numCols);
+  rowStart.clear();
+  rowStart.reserve(numRows + 1);
+  
+  //add rows of MRs
+  while(y < maxY + yDist)
+  {
+    if(indentRow)
+    { x=0; indentRow = false;}
+    else
+    { x=xDist/2; indentRow = true;}
+    
+    rowStart.push_back(currentID);
+    
+    //add cols of MRs
+    while(x < maxX + xDist)
+    {
+      MR.addRouter(x, y);
+      currentID++;
+      x=x+xDist;
+    }
+    y=y+yDist;
+  }
+  rowStart.push_back(currentID);
+  
+  generateNeighbours(range, xDist, yDist, MR);
+}
+
+/* ---- Private Functions ---- */
+
+/*
+ * Two MRs are neighbours if they are closer than range. Since MRs sit
+ * on known rows and columns, only the few lattice positions around each
+ * MR can qualify, so those are the only ones we measure: O(n) overall
+ * instead of comparing every pair.
+ */
+void Lattice::generateNeighbours(double range, double xDist, double yDist, RouterTable &MR)
+{
+  int numRows = getNumRows();
+  int rowReach = (int)ceil(range / yDist);
+  
+  offsets.clear();
+  offsets.reserve(MR.size() + 1);
+  offsets.push_back(0);
+  neighbours.clear();
+  
+  for(int row=0; row < numRows; row++)
+  {
+    for(int currentMR=rowStart[row]; currentMR < rowStart[row+1]; currentMR++)
+    {
+      double x = MR[currentMR].getX();
+      
+      /* rows are visited top to bottom and columns left to right, so ids stay sorted */
+      for(int r=row-rowReach; r <= row+rowReach; r++)
+      {
+        if(r < 0 || r >= numRows)
+          continue;
+        
+        int first = rowStart[r];
+        int count = rowStart[r+1] - first;
+        double rowX = MR[first].getX();
+        
+        int low = (int)floor((x - range - rowX) / xDist);
+        int high = (int)ceil((x + range - rowX) / xDist);
+        if(low < 0)
+          low = 0;
+        if(high > count-1)
+          high = count-1;
+        
+        for(int c=low; c <= high; c++)
+        {
+          int potentialNeighbour = first + c;
+          if(potentialNeighbour != currentMR && MR[currentMR].distance(MR[potentialNeighbour]) < range)
+            neighbours.push_back(potentialNeighbour);
+        }
+      }
+      offsets.push_back((int)neighbours.size());
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef LATTICE_H
+#define LATTICE_H
+
+#include <vector>         //std::vector
+
+#include "MeshRouter.h"
+
+/*
+ * Regular lattice of MRs with the neighbour sets stored as one flat
+ * CSR (compressed sparse row) array: the neighbours of router i are
+ * neighbours[offsets[i]] .. neighbours[offsets[i+1]-1]
+ */
+class Lattice
+{
+  public:
+  /* Constructors */
+  Lattice(){};
+  
+  /* Generation functions */
+  void generateHexagonal(double maxX, double maxY, double range, RouterTable &MR);
+  
+  /* Accessors */
+  int getNumRows(){return (int)rowStart.size()-1;};
+  int getDegree(int router_id){return offsets[router_id+1]-offsets[router_id];};
+  const int* neighboursBegin(int router_id){return neighbours.data()+offsets[router_id];};
+  const int* neighboursEnd(int router_id){return neighbours.data()+offsets[router_id+1];};
+  
+  private:
+  void generateNeighbours(double range, double xDist, double yDist, RouterTable &MR);
+  
+  std::vector<int> rowStart;      //id of the first MR in each row (plus one past the end)
+  std::vector<int> offsets;       //CSR row offsets, one per MR plus one
+  std::vector<int> neighbours;    //CSR neighbour ids, sorted by id for each MR
+};
+
+#endif
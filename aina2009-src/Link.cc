@@ -3,7 +3,7 @@
 
 #include "Link.h"
 
-bool Link::interfere(Link LS)
+bool Link::interfere(const Link &LS) const
 {
   if(destination_id == LS.getDestination() || source_id == LS.getSource() || source_id == LS.getDestination() || destination_id == LS.getSource())
     return true;
@@ -11,7 +11,7 @@ bool Link::interfere(Link LS)
     return false;
 }
 
-void Link::display()
+void Link::display() const
 {
   std::cout << "L: " << id << "\tS: " << source_id << "\tD: " << destination_id << "\t Req: " << getRequirement() << std::endl;
 }
@@ -11,19 +11,19 @@ class Link
   Link(int i, int s, int d){id=i;source_id = s;destination_id = d; requirement=0;};
   
   /* Functions */
-  bool interfere(Link LS);
+  bool interfere(const Link &LS) const;
   
   /* Accessors */
-  int getID(){return id;};
-  int getSource(){return source_id;};
-  int getDestination(){return destination_id;};
-  int getRequirement(){return requirement;};
+  int getID() const {return id;};
+  int getSource() const {return source_id;};
+  int getDestination() const {return destination_id;};
+  int getRequirement() const {return requirement;};
   
   /* Mutators */
   void setRequirement(int r){requirement = r;};
   
   /* Display */
-  void display();
+  void display() const;
   
   private:
   int id, source_id, destination_id, requirement;
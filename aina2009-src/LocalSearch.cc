@@ -0,0 +1,190 @@
+#ifndef LOCALSEARCH_CC
+#define LOCALSEARCH_CC
+
+#include <algorithm>      //std::push_heap, std::pop_heap
+
+#include "LocalSearch.h"
+
+LocalSearch::LocalSearch(const std::vector <Link> &links) : LS(links)
+{
+}
+
+/*
+ * Improves the scheduling in place, evaluating at most maxIterations moves
+ * and swaps, and returns by how many HOPDELAYs the frame got shorter
+ */
+int LocalSearch::improve(std::vector <Clique> &scheduling, int maxIterations)
+{
+  items.clear();
+  rounds.clear();
+  for(unsigned int c=0;c<scheduling.size();c++)
+    for(unsigned int l=0;l<scheduling[c].size();l++)
+    {
+      items.push_back(scheduling[c].getLink(l));
+      rounds.push_back(c);
+    }
+  generateConflicts();
+  
+  int numRounds = scheduling.size();
+  stamps.assign(items.size(), 0);
+  heaps.assign(numRounds, std::vector <Entry>());
+  for(unsigned int x=0;x<items.size();x++)
+    place(x, rounds[x]);
+  
+  int saved=0;
+  int iterations=0;
+  bool improved=true;
+  while(improved && iterations < maxIterations)
+  {
+    improved = false;
+    for(unsigned int x=0;x<items.size() && iterations < maxIterations;x++)
+    {
+      int a = rounds[x];
+      int requirement = LS[items[x]].getRequirement();
+      for(int b=0;b<numRounds && iterations < maxIterations;b++)
+      {
+        if(b == a)
+          continue;
+        
+        /* move x on its own */
+        iterations++;
+        if(!conflictsWith(x, b, -1))
+        {
+          int change = topWithout(a, x) - top(a) + std::max(top(b), requirement) - top(b);
+          if(change < 0)
+          {
+            place(x, b);
+            saved = saved - change;
+            improved = true;
+            break;
+          }
+        }
+        
+        /* swap x with each link y in b */
+        bool swapped = false;
+        std::vector <Entry> members = heaps[b];
+        for(unsigned int m=0;m<members.size() && !swapped && iterations < maxIterations;m++)
+        {
+          int y = members[m].item;
+          if(members[m].stamp != stamps[y] || conflictsWith(x, b, y) || conflictsWith(y, a, x))
+            continue;
+          iterations++;
+          int newA = std::max(topWithout(a, x), LS[items[y]].getRequirement());
+          int newB = std::max(topWithout(b, y), requirement);
+          int change = newA + newB - top(a) - top(b);
+          if(change < 0)
+          {
+            place(x, b);
+            place(y, a);
+            saved = saved - change;
+            swapped = true;
+          }
+        }
+        if(swapped)
+        {
+          improved = true;
+          break;
+        }
+      }
+    }
+  }
+  
+  /* rebuild the cliques, leaving out rounds which were emptied */
+  std::vector <Clique> result(numRounds);
+  for(unsigned int x=0;x<items.size();x++)
+    result[rounds[x]].addLink(items[x]);
+  scheduling.clear();
+  for(int c=0;c<numRounds;c++)
+    if(result[c].size() > 0)
+      scheduling.push_back(result[c]);
+  return saved;
+}
+
+/* ---- Private Functions ---- */
+
+/*
+ * Links conflict when they share an MR, so the conflicts come from the
+ * scheduled links at each MR
+ */
+void LocalSearch::generateConflicts()
+{
+  std::vector < std::vector <int> > atRouter;
+  for(unsigned int x=0;x<items.size();x++)
+  {
+    int ends[2] = {LS[items[x]].getSource(), LS[items[x]].getDestination()};
+    for(int e=0;e<2;e++)
+    {
+      if(ends[e] >= (int)atRouter.size())
+        atRouter.resize(ends[e]+1);
+      atRouter[ends[e]].push_back(x);
+    }
+  }
+  
+  conflicts.assign(items.size(), std::vector <int>());
+  for(unsigned int r=0;r<atRouter.size();r++)
+    for(unsigned int a=0;a<atRouter[r].size();a++)
+      for(unsigned int b=0;b<atRouter[r].size();b++)
+        if(a != b)
+          conflicts[atRouter[r][a]].push_back(atRouter[r][b]);
+}
+
+/*
+ * Returns true if x conflicts with any link in the round apart from ignore
+ */
+bool LocalSearch::conflictsWith(int x, int round, int ignore)
+{
+  for(unsigned int n=0;n<conflicts[x].size();n++)
+  {
+    int y = conflicts[x][n];
+    if(y != ignore && rounds[y] == round)
+      return true;
+  }
+  return false;
+}
+
+/*
+ * Returns the weight of the round, dropping stale entries off its heap
+ */
+int LocalSearch::top(int round)
+{
+  std::vector <Entry> &heap = heaps[round];
+  while(!heap.empty() && heap.front().stamp != stamps[heap.front().item])
+  {
+    std::pop_heap(heap.begin(), heap.end());
+    heap.pop_back();
+  }
+  return heap.empty() ? 0 : heap.front().requirement;
+}
+
+/*
+ * Returns the weight the round would have without x
+ */
+int LocalSearch::topWithout(int round, int x)
+{
+  int weight = top(round);
+  std::vector <Entry> &heap = heaps[round];
+  if(heap.empty() || heap.front().item != x)
+    return weight;
+  
+  Entry first = heap.front();
+  std::pop_heap(heap.begin(), heap.end());
+  heap.pop_back();
+  weight = top(round);
+  heap.push_back(first);
+  std::push_heap(heap.begin(), heap.end());
+  return weight;
+}
+
+/*
+ * Puts x into the round, which makes any entry it has elsewhere stale
+ */
+void LocalSearch::place(int x, int round)
+{
+  stamps[x]++;
+  rounds[x] = round;
+  Entry e = {LS[items[x]].getRequirement(), x, stamps[x]};
+  heaps[round].push_back(e);
+  std::push_heap(heaps[round].begin(), heaps[round].end());
+}
+
+#endif
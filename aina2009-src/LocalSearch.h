@@ -0,0 +1,45 @@
+#ifndef LOCALSEARCH_H
+#define LOCALSEARCH_H
+
+#include <vector>         //std::vector
+
+#include "Link.h"
+#include "Clique.h"
+
+/*
+ * Post-pass which shortens a scheduling by moving single links to another
+ * round, or swapping two links between rounds, whenever that lowers the
+ * sum of the round weights and keeps every round conflict-free. Each round
+ * keeps a max-heap of its requirements, so the change in length of a move
+ * is found from the heap tops without rescanning the rounds. Removed links
+ * are left in the heaps and skipped when they reach the top.
+ */
+class LocalSearch
+{
+  public:
+  LocalSearch(const std::vector <Link> &links);
+  int improve(std::vector <Clique> &scheduling, int maxIterations);
+  
+  private:
+  struct Entry
+  {
+    int requirement, item, stamp;
+    bool operator<(const Entry &e) const {return requirement < e.requirement;};
+  };
+  
+  void generateConflicts();
+  bool conflictsWith(int x, int round, int ignore);
+  int top(int round);
+  int topWithout(int round, int x);
+  void place(int x, int round);
+  
+  const std::vector <Link> &LS;   //all the links (owned by the Simulation)
+  
+  std::vector <int> items;        //link id of each scheduled link
+  std::vector <int> rounds;       //round of each scheduled link
+  std::vector <int> stamps;       //bumped on every move, older heap entries are stale
+  std::vector < std::vector <int> > conflicts;
+  std::vector < std::vector <Entry> > heaps;
+};
+
+#endif
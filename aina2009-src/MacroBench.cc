@@ -0,0 +1,145 @@
+/*
+ * Scaling benchmark: runs complete simulations over a grid of lattice
+ * sizes (and so numbers of MRs), numbers of GWs, with and without FS and
+ * at two arrival rates, and prints one JSON report to stdout. For each
+ * point it gives the wall time, events handled per second, the peak
+ * resident memory, the deepest the event queue got and the share of the
+ * time spent building schedules. Every point runs in its own child process
+ * so its peak memory is its own, and is stopped after POINT_TIME_LIMIT.
+ * There are no MCs to vary here, packets start at random positions.
+ *
+ * usage: ./wmn-macrobench [config files] [KEY=value ...] > macrobench.json
+ * (the parameters are the base for every point, see Parameters.h)
+ */
+
+#include <iostream>       //std::cout, std::cerr
+#include <cstdio>         //freopen
+#include <chrono>         //std::chrono::steady_clock
+#include <unistd.h>       //fork, pipe, alarm, _exit
+#include <sys/wait.h>     //wait4
+#include <sys/resource.h> //struct rusage
+
+#include "Simulation.h"
+
+#define POINT_TIME_LIMIT 300
+
+/* what a child process sends back for one point */
+struct PointResult
+{
+  double wallSeconds, scheduleSeconds, pdr;
+  long events;
+  unsigned int peakQueue;
+  int numMRs;
+};
+
+/*
+ * Runs every repeat of the scenario, with the output thrown away
+ */
+static PointResult runPoint(const Parameters &params)
+{
+  PointResult result = {0, 0, 0, 0, 0, 0};
+  std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now();
+  
+  Simulation sim(params);
+  sim.generateHexagonalTopology();
+  if(params.fs_enabled)
+    sim.generateLinks();
+  
+  for(int repeat=0; repeat < params.repeats; repeat++)
+  {
+    sim.reset();
+    sim.start();
+    result.events = result.events + sim.getEvents();
+    result.scheduleSeconds = result.scheduleSeconds + sim.getScheduleSeconds();
+    result.pdr = result.pdr + sim.getPacketDeliveryRatio() / params.repeats;
+    if(sim.getPeakQueue() > result.peakQueue)
+      result.peakQueue = sim.getPeakQueue();
+  }
+  
+  result.numMRs = sim.getNumMRs();
+  result.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+  return result;
+}
+
+/*
+ * Runs the point in a child process and writes its JSON object
+ */
+static void measurePoint(const Parameters &params, bool first)
+{
+  int fds[2];
+  if(pipe(fds) != 0)
+  {
+    std::cout << "Error, could not create a pipe" << std::endl;
+    exit(255);
+  }
+  
+  std::cout.flush();    //or the child would write out our buffer again
+  pid_t child = fork();
+  if(child == 0)
+  {
+    close(fds[0]);
+    if(!freopen("/dev/null", "w", stdout))
+      _exit(255);
+    alarm(POINT_TIME_LIMIT);
+    PointResult result = runPoint(params);
+    _exit(write(fds[1], &result, sizeof(result)) == sizeof(result) ? 0 : 255);
+  }
+  close(fds[1]);
+  
+  PointResult result;
+  bool finished = read(fds[0], &result, sizeof(result)) == sizeof(result);
+  close(fds[0]);
+  
+  int status;
+  struct rusage usage;
+  wait4(child, &status, 0, &usage);
+  
+  std::cout << (first ? "" : ",") << std::endl;
+  std::cout << "    {\"max_x\": " << params.max_x << ", \"max_y\": " << params.max_y
+            << ", \"num_gws\": " << params.num_gws << ", \"fs_enabled\": " << (params.fs_enabled ? "true" : "false")
+            << ", \"mean\": " << params.mean << ", \"peak_rss_kb\": " << usage.ru_maxrss;
+  if(finished)
+  {
+    std::cout << ", \"num_mrs\": " << result.numMRs << ", \"wall_seconds\": " << result.wallSeconds
+              << ", \"events\": " << result.events << ", \"events_per_second\": " << result.events / result.wallSeconds
+              << ", \"peak_queue\": " << result.peakQueue << ", \"schedule_share\": " << result.scheduleSeconds / result.wallSeconds
+              << ", \"pdr\": " << result.pdr << ", \"timed_out\": false}";
+  }
+  else
+    std::cout << ", \"timed_out\": true}";
+  
+  std::cerr << "max_x " << params.max_x << " gws " << params.num_gws << " fs " << params.fs_enabled << " mean " << params.mean
+            << (finished ? " done" : " timed out") << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+  Parameters base = readScenarios(argc, argv)[0];
+  const double sizes[] = {80, 160, 240};
+  const int gateways[] = {1, 2};
+  const double rates[] = {1, 0.5};    //multiples of the base MEAN
+  
+  std::cout << "{" << std::endl << "  \"simulator\": \"aina2009\"," << std::endl;
+  std::cout << "  \"repeats\": " << base.repeats << ", \"num_packets\": " << base.num_packets << ", \"scheduler\": " << base.scheduler << "," << std::endl;
+  std::cout << "  \"points\": [";
+  
+  bool first = true;
+  for(unsigned int s=0;s<sizeof(sizes)/sizeof(sizes[0]);s++)
+    for(unsigned int g=0;g<sizeof(gateways)/sizeof(gateways[0]);g++)
+      for(int fs=0;fs<2;fs++)
+        for(unsigned int r=0;r<sizeof(rates)/sizeof(rates[0]);r++)
+        {
+          Parameters params = base;
+          params.max_x = sizes[s];
+          params.max_y = sizes[s];
+          params.num_gws = gateways[g];
+          params.fs_enabled = fs;
+          params.mean = base.mean * rates[r];
+          params.display_progress = false;
+          measurePoint(params, first);
+          first = false;
+        }
+  
+  std::cout << std::endl << "  ]" << std::endl << "}" << std::endl;
+  return 0;
+}
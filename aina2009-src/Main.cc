@@ -0,0 +1,148 @@
+/*
+ * C++ Discrete Event Simulation
+ * for Wireless Mesh Networks
+ * by Jason Ernst
+ * University of Guelph, ON, Canada
+ * 
+ * Command line entry point, see Simulation.cc for the simulation itself
+ */
+
+#include "Simulation.h"
+#include "Timeline.h"
+#include "EventTrace.h"
+#include "WorkerPool.h"
+#include <memory>         //std::unique_ptr
+#include <ctime>          //time
+#include <cmath>          //fabs
+#include <algorithm>      //std::min, std::max
+
+/* One replication, on a thread of the WorkerPool when runs are made in batches */
+static void runReplication(Simulation *sim, int repeat)
+{
+  Timeline::Span replicationSpan("replication", repeat);
+  sim->reset();
+  sim->start();
+}
+
+/* True once the confidence interval of stat is within precision of its mean */
+static bool precise(const RunningStat &stat, double precision)
+{
+  return stat.getHalfWidth() <= precision * fabs(stat.getMean());
+}
+
+/*
+ * Main Function, runs every scenario given by the config files and
+ * command line arguments (see readScenarios in Parameters.cc)
+ * 
+ * With PRECISION set, runs are made in batches of THREADS, each on its
+ * own Simulation and random stream, until at least REPEATS runs are done
+ * and the 95% CIs of delay and PDR are within PRECISION of their means,
+ * or MAX_REPEATS runs are done.
+ */
+int main(int argc, char *argv[])
+{
+  std::vector<Parameters> scenarios = readScenarios(argc, argv);
+  std::unique_ptr<WorkerPool> pool;   //the threads for the batches, ended before exit so their trace buffers are written
+  
+  for(unsigned int s=0; s < scenarios.size(); s++)
+  {
+    Parameters &params = scenarios[s];
+    double totalDelay = 0;
+    double totalPacketDeliveryRatio=0;
+    RunningStat delays, dropDelays, steadyStateDelays, packetDeliveryRatios;   //over the runs, for the confidence intervals
+    int numMRs = 0;
+    int numGWs = 0;
+    
+    if(argc > 1)
+      params.display();
+    if(!params.trace_file.empty())
+      Timeline::open(params.trace_file);
+    if(!params.event_trace.empty())
+      EventTrace::open(params.event_trace);
+    Timeline::Span scenarioSpan("scenario", s);
+    
+    bool sequential = params.precision > 0;
+    int threads = sequential ? std::max(1, params.threads) : 1;
+    int maxRepeats = sequential ? std::max(params.repeats, params.max_repeats) : params.repeats;
+    long seed = time(NULL);
+    
+    /*
+     * Runs on several threads at once must not write their progress over
+     * each other, and the counters only follow the thread which opened them
+     */
+    Parameters runParams = params;
+    if(threads > 1)
+    {
+      runParams.display_progress = false;
+      runParams.perf_counters = false;
+    }
+    
+    /* Initialize the Simulators, the topology is the same for every run */
+    std::vector<std::unique_ptr<Simulation> > sims;
+    for(int t=0; t < threads; t++)
+    {
+      sims.push_back(std::unique_ptr<Simulation>(new Simulation(runParams)));
+      sims[t]->generateHexagonalTopology();
+    }
+
+    std::cout << "MR: " << sims[0]->getNumMRs() << std::endl;
+    
+    if(params.fs_enabled)
+      for(int t=0; t < threads; t++)
+      { sims[t]->generateLinks(); }
+    
+    /* the threads are started once and shared by the scenarios, every batch runs on them */
+    if(!pool || pool->size() != threads)
+      pool.reset(new WorkerPool(threads));
+    int repeat = 0;
+    while(repeat < maxRepeats)
+    {
+      if(sequential && repeat >= std::max(params.repeats, 2) && precise(delays, params.precision) && precise(packetDeliveryRatios, params.precision))
+        break;
+      
+      /* New GWs and a clean run state, reusing the memory of the last run */
+      int batch = std::min(threads, maxRepeats - repeat);
+      if(sequential)
+        for(int t=0; t < batch; t++)
+          sims[t]->seedReplication(seed, repeat + t);
+      pool->run(batch, [&](int t){runReplication(sims[t].get(), repeat + t);});
+      
+      for(int t=0; t < batch; t++, repeat++)
+      {
+        Simulation &sim = *sims[t];
+        
+        /* Stats */
+        totalDelay = totalDelay + sim.getAvgDelay();
+        totalPacketDeliveryRatio = totalPacketDeliveryRatio + sim.getPacketDeliveryRatio();
+        delays.add(sim.getAvgDelay());
+        dropDelays.add(sim.getAvgDropDelay());
+        if(sim.hasSteadyStateDelay())
+          steadyStateDelays.add(sim.getSteadyStateDelay());
+        packetDeliveryRatios.add(sim.getPacketDeliveryRatio());
+        numMRs = sim.getNumMRs();
+        numGWs = sim.getNumGWs();
+        
+        /* Display Statistics for each run*/
+        sim.displayStats();
+        
+        /* Progress */
+        if(params.display_progress)
+        {
+          std::cout << "Progress: Run " << repeat+1 << " out of " << maxRepeats 
+<< std::endl;
+        }
+      }
+    }
+    std::cout << "Successfully ran " << repeat << " runs. Stats: " << std::endl;
+    std::cout << "AVG DELAY: " << totalDelay / (double)repeat << std::endl;
+    std::cout << "AVG PDR: " << totalPacketDeliveryRatio / (double)repeat << std::endl;
+    std::cout << "95% CI: DELAY +/- " << delays.getHalfWidth() << "\tPDR +/- " << packetDeliveryRatios.getHalfWidth() << std::endl;
+    std::cout << "AVG DROP DELAY: " << dropDelays.getMean() << " +/- " << dropDelays.getHalfWidth() << std::endl;
+    if(params.warmup && steadyStateDelays.getCount() == 0)
+      std::cout << "AVG STEADY-STATE DELAY: insufficient data (MSER-5 needs " << 2 * MSER_GROUPS * MSER_BATCH << " delivered packets per run)" << std::endl;
+    else if(params.warmup)
+      std::cout << "AVG STEADY-STATE DELAY: " << steadyStateDelays.getMean() << " +/- " << steadyStateDelays.getHalfWidth() << " (" << steadyStateDelays.getCount() << " runs)" << std::endl;
+    std::cout << "MRs: " << numMRs << " GWs: " << numGWs << std::endl;
+  }
+  return 0;
+}
@@ -6,7 +6,7 @@
 /* 
  * Construct a Compatibility Matrix
  */
-Matrix::Matrix(std::vector <Link> links)
+Matrix::Matrix(const std::vector <Link> &links) : LS(links)
 {
   /* Allocate Memory for Boolean Matrix */
   int num_links = (int)links.size();
@@ -18,8 +18,9 @@ Matrix::Matrix(std::vector <Link> links)
   for(int x=0;x<num_links;x++)
     for(int y=0;y<num_links;y++)
       CM[x][y] = false;
-      
-  LS = links;
+  
+  Timeline::Span span("compatibility");
+  generateCompatibilities();
 }
 
 /*
@@ -27,11 +28,39 @@ Matrix::Matrix(std::vector <Link> links)
  * based on the Link data provided
  */
 std::vector <Clique> Matrix::generateScheduling()
+{
+  ScheduleBudget unlimited;
+  return generateScheduling(unlimited);
+}
+
+/*
+ * As above, but stops generating cliques once the budget is exhausted
+ * and schedules from the cliques found so far. Links which are not in any
+ * of them are added as single link cliques, so every link still gets a turn.
+ */
+std::vector <Clique> Matrix::generateScheduling(ScheduleBudget &budget)
 {
   std::vector <Clique> scheduling;
   
-  generateCompatibilities();
-  generateAllCliques();
+  {
+    Timeline::Span span("clique enumeration");
+    generateAllCliques(budget);
+  }
+  Timeline::Span span("clique selection");
+  
+  if(budget.exhausted())
+  {
+    for(unsigned int l=0;l<LS.size();l++)
+    {
+      Clique singleLink;
+      singleLink.addLink(l);
+      bool covered = false;
+      for(unsigned int c=0;c<CL.size() && !covered;c++)
+        covered = CL[c].exists(l);
+      if(!covered)
+        CL.push_back(singleLink);
+    }
+  }
   
   /*
   for(unsigned int x=0;x<CL.size();x++)
@@ -75,6 +104,40 @@ std::vector <Clique> Matrix::generateScheduling()
   return scheduling;
 }
 
+/*
+ * Returns how many HOPDELAYs the scheduling takes, the sum of the clique weights
+ */
+int Matrix::getLength(const std::vector <Clique> &scheduling)
+{
+  int length=0;
+  for(unsigned int c=0;c<scheduling.size();c++)
+    length = length + scheduling[c].getWeight(LS);
+  return length;
+}
+
+/*
+ * Returns a lower bound on the length of any scheduling. Links sharing an
+ * MR always interfere, so the busiest MR needs the sum of its requirements.
+ */
+int Matrix::getLowerBound()
+{
+  std::vector <int> load;
+  int bound=0;
+  for(unsigned int l=0;l<LS.size();l++)
+  {
+    int ends[2] = {LS[l].getSource(), LS[l].getDestination()};
+    for(int e=0;e<2;e++)
+    {
+      if(ends[e] >= (int)load.size())
+        load.resize(ends[e]+1, 0);
+      load[ends[e]] = load[ends[e]] + LS[l].getRequirement();
+      if(load[ends[e]] > bound)
+        bound = load[ends[e]];
+    }
+  }
+  return bound;
+}
+
 /*
  * Displays the compatibility matrix
  * (needs to be fixed for easy reading)
@@ -116,9 +179,9 @@ void Matrix::displayCM()
 /*
  * Generates all of the cliques based on the compatibility matrix
  */
-void Matrix::generateAllCliques()
+void Matrix::generateAllCliques(ScheduleBudget &budget)
 {  
-  for(unsigned int l1=0; l1<LS.size();l1++)
+  for(unsigned int l1=0; l1<LS.size() && budget.spend(LS.size()+CL.size());l1++)
   {
     /* Generate the cliques of largest size */
     Clique c;
@@ -137,7 +200,7 @@ void Matrix::generateAllCliques()
     if(isUnique(c))
     {
       CL.push_back(c);
-      generateSubCliques(c);
+      generateSubCliques(c, budget);
     }
     
     /* Generate the cliques of size 1 */
@@ -151,9 +214,9 @@ void Matrix::generateAllCliques()
 /*
  * Generates a vector of all the subCliques from a larger clique
  */
-void Matrix::generateSubCliques(Clique largeClique)
+void Matrix::generateSubCliques(const Clique &largeClique, ScheduleBudget &budget)
 {
-  for(unsigned int skipper=0;skipper<largeClique.size();skipper++)
+  for(unsigned int skipper=0;skipper<largeClique.size() && budget.spend(CL.size()+1);skipper++)
   {
     Clique smallerClique;
     for(unsigned int x=0; x<largeClique.size();x++)
@@ -177,7 +240,7 @@ void Matrix::generateSubCliques(Clique largeClique)
       if(isUnique(smallerClique))
       {
         CL.push_back(smallerClique);
-        generateSubCliques(smallerClique);
+        generateSubCliques(smallerClique, budget);
       }
   }
 }
@@ -202,7 +265,7 @@ void Matrix::generateCompatibilities()
  * Makes sure that a potential link is compatible with the
  * links which already exist in the clique
  */
-bool Matrix::isCompatibleWithExisting(int x, Clique existing)
+bool Matrix::isCompatibleWithExisting(int x, const Clique &existing)
 {
   for(unsigned int c=0;c<existing.size();c++)
     if(!isCompatible(LS[x].getID(), existing.getLink(c)))
@@ -213,7 +276,7 @@ bool Matrix::isCompatibleWithExisting(int x, Clique existing)
 /*
  * Returns true if a potentialClique does not exist in CL yet
  */
-bool Matrix::isUnique(Clique potentialClique)
+bool Matrix::isUnique(const Clique &potentialClique)
 {
   for(unsigned int c=0;c<CL.size();c++)
   {
@@ -6,27 +6,34 @@
 
 #include "Link.h"
 #include "Clique.h"
+#include "ScheduleBudget.h"
+#include "Timeline.h"
 
 class Matrix
 {
   public:
-  Matrix(std::vector <Link> links);
+  Matrix(const std::vector <Link> &links);
   std::vector <Clique> generateScheduling();
+  std::vector <Clique> generateScheduling(ScheduleBudget &budget);
+  
+  /* Frame lengths in HOPDELAYs */
+  int getLength(const std::vector <Clique> &scheduling);
+  int getLowerBound();
   
   /* Display Functions */
   void displayCM();
   
   private:
   void setCompatible(int x, int y);
-  void generateAllCliques();
+  void generateAllCliques(ScheduleBudget &budget);
   void generateCompatibilities();
-  void generateSubCliques(Clique largeClique);
-  bool isUnique(Clique potentialClique);
+  void generateSubCliques(const Clique &largeClique, ScheduleBudget &budget);
+  bool isUnique(const Clique &potentialClique);
   bool isCompatible(int x, int y);
-  bool isCompatibleWithExisting(int x, Clique existing);
+  bool isCompatibleWithExisting(int x, const Clique &existing);
   bool** CM;                      //compat matrix
   std::vector <Clique> CL;        //all of the cliques
-  std::vector <Link> LS;          //all the links
+  const std::vector <Link> &LS;   //all the links (owned by the Simulation)
 };
 
 #endif
@@ -3,48 +3,46 @@
 
 #include <iostream>       //std::cout/cin, srand48, drand48
 #include <cmath>          //sqrt
-#include <vector>         //std::vector
 
+#include "RouterTable.h"
+
+/*
+ * View of a single MR stored in a RouterTable. It only holds the table
+ * and the id, so it is cheap to create and pass around by value.
+ */
 class MeshRouter
 {
   public:
   /* Constructors */
-  MeshRouter(){id=-1;x=-1;y=-1;gateway=false; permission=false; busy=false; buffer=-1; retries=0;};
-  MeshRouter(int newID, double newX, double newY){id=newID;x=newX;y=newY;gateway=false; permission=false; busy=false; buffer=-1; retries=0;};
+  MeshRouter(RouterTable *newTable, int newID){table=newTable; id=newID;};
   
   /* Accessors */
-  double getX(){return x;};
-  double getY(){return y;};
-  int getID(){return id;};
-  int getBuffer(){return buffer;};
-  bool isGateway(){return gateway;};
-  bool isBusy(){return busy;};
-  bool hasPermission(){return permission;};
-  std::vector<int> getNeighbours(){return neighbours;};
-  int getRetries(){return retries;};
+  double getX() const {return table->x[id];};
+  double getY() const {return table->y[id];};
+  int getID() const {return id;};
+  bool isGateway() const {return RouterTable::testBit(table->gateway, id);};
+  bool isBusy() const {return RouterTable::testBit(table->busy, id);};
+  bool hasPermission() const {return RouterTable::testBit(table->permission, id);};
   
   /* Mutators */
-  void setGateway(){gateway=true;};
-  void addNeighbour(int neighbour_id);
-  void setPermission(bool p){permission=p;};
-  void setBusy(bool b){busy=b;};
-  void setBuffer(int b){buffer=b;};  
-  void setRetries(int r){retries = r;};
+  void setGateway(){RouterTable::setBit(table->gateway, id, true);};
+  void setPermission(bool p){RouterTable::setBit(table->permission, id, p);};
+  void setBusy(bool b){RouterTable::setBit(table->busy, id, b);};
   
   /* Functions */
-  double distance(MeshRouter MR);
+  double distance(const MeshRouter &MR) const;
   
   /* Display */
   void display();
   
   private:
-  
-  void displayNeighbours();
-  
-  std::vector<int> neighbours;
-  int id, buffer, retries;
-  double x,y;
-  bool gateway, permission, busy;
+  RouterTable *table;
+  int id;
 };
 
+inline MeshRouter RouterTable::operator[](int router_id)
+{
+  return MeshRouter(this, router_id);
+}
+
 #endif
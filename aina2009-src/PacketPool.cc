@@ -0,0 +1,53 @@
+#ifndef PACKETPOOL_CC
+#define PACKETPOOL_CC
+
+#include "PacketPool.h"
+#include <iostream>       //std::cout
+#include <cstdlib>        //exit
+
+/*
+ * Preallocates room for capacity packets and frees all of them
+ */
+void PacketPool::resize(int capacity)
+{
+  packets.resize(capacity);
+  freePackets.resize(capacity);
+  
+  /* hand out the lowest ids first */
+  for(int p=0; p<capacity; p++)
+    freePackets[p] = capacity-1-p;
+  used = 0;
+}
+
+/*
+ * Takes a free record for a new packet and returns its id
+ */
+int PacketPool::allocate(int source, int destination, double created)
+{
+  if(freePackets.empty())
+  {
+    std::cout << "Error, the packet pool is exhausted (" << packets.size() << " packets)" << std::endl;
+    exit(255);
+  }
+  
+  int p = freePackets.back();
+  freePackets.pop_back();
+  packets[p].source = source;
+  packets[p].destination = destination;
+  packets[p].created = created;
+  packets[p].retries = 0;
+  packets[p].hops = 0;
+  used++;
+  return p;
+}
+
+/*
+ * Returns a finished packet's record to the pool
+ */
+void PacketPool::release(int packet_id)
+{
+  freePackets.push_back(packet_id);
+  used--;
+}
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef PACKETPOOL_H
+#define PACKETPOOL_H
+
+#include <vector>         //std::vector
+
+/*
+ * A packet in flight: where it entered the mesh, where it is going,
+ * when it was created, how many times it has retried its current hop
+ * and how many hops it has made
+ */
+struct Packet
+{
+  int id;                 //order it was created in its run, from 1
+  int source, destination;
+  double created;
+  int retries;
+  int hops;
+};
+
+/*
+ * Fixed pool of packet records. Every packet in the simulation lives in
+ * one of the pool's slots and is referred to by its index, so creating
+ * and finishing packets never touches the allocator.
+ */
+class PacketPool
+{
+  public:
+  /* Mutators */
+  void resize(int capacity);
+  int allocate(int source, int destination, double created);
+  void release(int packet_id);
+  
+  /* Accessors */
+  Packet &operator[](int packet_id){return packets[packet_id];};
+  int size() const {return used;};
+  int capacity() const {return (int)packets.size();};
+  
+  private:
+  std::vector<Packet> packets;
+  std::vector<int> freePackets;
+  int used;
+};
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef PACKETQUEUE_CC
+#define PACKETQUEUE_CC
+
+#include "PacketQueue.h"
+#include <iostream>       //std::cout
+#include <cstdlib>        //exit
+
+/*
+ * Empties every queue and makes room for newCapacity packets per MR
+ */
+void PacketQueue::resize(int num_routers, int newCapacity)
+{
+  if(newCapacity < 1)
+  {
+    std::cout << "Error, each MR must be able to queue at least one packet" << std::endl;
+    exit(255);
+  }
+  capacity = newCapacity;
+  slots.assign(num_routers * capacity, -1);
+  priorities.assign(num_routers * capacity, 0);
+  head.assign(num_routers, 0);
+  count.assign(num_routers, 0);
+}
+
+/*
+ * Adds the packet to the back of the MR's queue (first in, first out).
+ * The caller must make sure the queue is not full.
+ */
+void PacketQueue::push(int router_id, int packet_id)
+{
+  slots[slot(router_id, count[router_id])] = packet_id;
+  count[router_id]++;
+}
+
+/*
+ * Inserts the packet behind every queued packet with a lower or equal
+ * priority value, but never ahead of the packet being sent. The caller
+ * must make sure the queue is not full.
+ */
+void PacketQueue::push(int router_id, int packet_id, double priority)
+{
+  int position = count[router_id];
+  while(position > 1 && priorities[slot(router_id, position-1)] > priority)
+  {
+    slots[slot(router_id, position)] = slots[slot(router_id, position-1)];
+    priorities[slot(router_id, position)] = priorities[slot(router_id, position-1)];
+    position--;
+  }
+  slots[slot(router_id, position)] = packet_id;
+  priorities[slot(router_id, position)] = priority;
+  count[router_id]++;
+}
+
+/*
+ * Removes and returns the packet at the front of the MR's queue
+ */
+int PacketQueue::pop(int router_id)
+{
+  int packet_id = front(router_id);
+  head[router_id] = (head[router_id]+1) % capacity;
+  count[router_id]--;
+  return packet_id;
+}
+
+#endif
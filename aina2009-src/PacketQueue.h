@@ -0,0 +1,40 @@
+#ifndef PACKETQUEUE_H
+#define PACKETQUEUE_H
+
+#include <vector>         //std::vector
+
+/*
+ * Bounded queue of packet ids for every MR. All of the queues are ring
+ * buffers carved out of one flat array (capacity slots per MR), so they
+ * are allocated once per run and never grow.
+ * 
+ * The packet at the front is the one the MR is currently sending, so
+ * ordered (priority) pushes never place a packet ahead of it.
+ */
+class PacketQueue
+{
+  public:
+  /* Mutators */
+  void resize(int num_routers, int newCapacity);
+  void push(int router_id, int packet_id);
+  void push(int router_id, int packet_id, double priority);
+  int pop(int router_id);
+  
+  /* Accessors */
+  bool empty(int router_id) const {return count[router_id] == 0;};
+  bool full(int router_id) const {return count[router_id] == capacity;};
+  int size(int router_id) const {return count[router_id];};
+  int front(int router_id) const {return slots[slot(router_id, 0)];};
+  int at(int router_id, int position) const {return slots[slot(router_id, position)];};
+  
+  private:
+  int slot(int router_id, int position) const
+  {return router_id*capacity + (head[router_id]+position) % capacity;};
+  
+  int capacity;
+  std::vector<int> slots;
+  std::vector<double> priorities;
+  std::vector<int> head, count;
+};
+
+#endif
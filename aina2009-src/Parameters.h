@@ -0,0 +1,115 @@
+#ifndef PARAMETERS_H
+#define PARAMETERS_H
+
+#include <string>         //std::string
+#include <vector>         //std::vector
+
+/*
+ * Every tunable knob of a Simulation. The constructor fills in the
+ * defaults, and config files and KEY=value arguments can override any
+ * of them at runtime, so a sweep needs no rebuild. The keys are the
+ * names given to visit() below, e.g. HOPDELAY=0.02.
+ */
+struct Parameters
+{
+  Parameters();
+  
+  bool set(const std::string &key, const std::string &value);
+  void display();
+  
+  /*
+   * Calls v(key, field) for every parameter, so setting and displaying
+   * them by name share one list
+   */
+  template <class Visitor>
+  void visit(Visitor &v)
+  {
+    v("REPEATS", repeats);
+    v("PRECISION", precision);
+    v("MAX_REPEATS", max_repeats);
+    v("THREADS", threads);
+    v("FS_ENABLED", fs_enabled);
+    v("NUM_GWS", num_gws);
+    v("START", start);
+    v("END", end);
+    v("WARMUP", warmup);
+    v("STEADY_PRECISION", steady_precision);
+    v("NUMPACKETS", num_packets);
+    v("MEAN", mean);
+    v("HOPDELAY", hop_delay);
+    v("MAX_RETRIES", max_retries);
+    v("MAX_RETRY_TIME", max_retry_time);
+    v("WAIT_LISTS", wait_lists);
+    v("MAX_WAIT_TIME", max_wait_time);
+    v("TICKS_PER_SECOND", ticks_per_second);
+    v("QUEUE_CAPACITY", queue_capacity);
+    v("QUEUE_PRIORITY", queue_priority);
+    v("SCHEDULER", scheduler);
+    v("SCHEDULE_OPS", schedule_ops);
+    v("LOCAL_SEARCH", local_search);
+    v("SCHEDULE_TIME", schedule_time);
+    v("UPDOWN_RATIO", updown_ratio);
+    v("MAX_X", max_x);
+    v("MAX_Y", max_y);
+    v("MR_RANGE", mr_range);
+    v("MC_RANGE", mc_range);
+    v("DEBUGGING", debugging);
+    v("PROFILE_EVENTS", profile_events);
+    v("TRACE_FILE", trace_file);
+    v("EVENT_TRACE", event_trace);
+    v("PERF_COUNTERS", perf_counters);
+    v("DISPLAY_PROGRESS", display_progress);
+  };
+  
+  std::string name;             //name of the scenario in the config file
+  
+  int repeats;                  //how many times sim should repeat for more consistent results
+  double precision;             //repeat until the 95% CIs of delay and PDR are within this fraction of their means (0 runs exactly REPEATS)
+  int max_repeats;              //most runs to make when repeating to a precision
+  int threads;                  //runs at once when repeating to a precision
+  
+  bool fs_enabled;
+  int num_gws;
+  
+  double start;                 //time in seconds
+  double end;
+  bool warmup;                  //detects the warm-up of each run with MSER-5 and reports the delay without it (see StreamStats.h)
+  double steady_precision;      //with WARMUP, ends a run once the 95% CI of its steady-state delay is within this fraction of the mean (0 runs to END or NUMPACKETS)
+  int num_packets;
+  double mean;                  //inter-arrival time
+  double hop_delay;
+  int max_retries;
+  double max_retry_time;
+  bool wait_lists;              //park blocked HOPs until permission is given instead of retrying after a random backoff
+  double max_wait_time;         //drop a parked packet once it has waited this long for permission (0 waits indefinitely)
+  double ticks_per_second;      //integer event times with this resolution, e.g. 1e9 for ns (0 uses double times)
+  int queue_capacity;           //packets each MR can hold, including the one being sent
+  bool queue_priority;          //serve queued packets closest to their destination first instead of in arrival order
+  int scheduler;                //which engine builds the schedules, see below
+  int schedule_ops;             //operation budget for each schedule (0 is unlimited)
+  double schedule_time;         //wall-clock budget in seconds for each schedule (0 is unlimited)
+  int local_search;             //moves and swaps tried to shorten each schedule (0 turns the local search off)
+  
+  double updown_ratio;          //ratio of uplink packets to downlink packets
+  
+  double max_x;
+  double max_y;
+  double mr_range;
+  double mc_range;
+  
+  bool debugging;               //toggles debugging information
+  bool profile_events;          //times every event handler, by event type (see EventProfile.h)
+  std::string trace_file;       //writes a Chrome trace of the simulator phases here at exit (see Timeline.h)
+  std::string event_trace;      //writes every event to this binary file (see EventTrace.h)
+  bool perf_counters;           //reads the hardware counters around each phase (see PerfCounters.h)
+  bool display_progress;        //toggles displaying % completed
+};
+
+/* Schedulers */
+#define CLIQUE_SCHEDULER 0      //greedy over all the compatible cliques (Matrix)
+#define DSATUR_SCHEDULER 1      //DSATUR colouring of the conflict graph (Coloring)
+#define LRF_SCHEDULER 2         //largest requirement first colouring (Coloring)
+
+std::vector<Parameters> readScenarios(int argc, char *argv[]);
+
+#endif
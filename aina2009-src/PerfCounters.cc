@@ -0,0 +1,163 @@
+#ifndef PERFCOUNTERS_CC
+#define PERFCOUNTERS_CC
+
+#include "PerfCounters.h"
+#include <iostream>       //std::cout
+#include <cstring>        //memset, strerror
+#include <cerrno>         //errno
+#ifdef __linux__
+#include <unistd.h>       //read, close, syscall
+#include <sys/syscall.h>  //__NR_perf_event_open
+#include <linux/perf_event.h>
+#endif
+
+static const char *phaseNames[PERF_PHASES] = {"Topology", "Dispatch", "Scheduling"};
+static bool reported = false;     //why the counters are unavailable is only said once
+
+PerfCounters::PerfCounters()
+{
+  leader = -1;
+  opened = 0;
+  for(int c=0;c<PERF_COUNTERS;c++)
+  {
+    fds[c] = -1;
+    slots[c] = -1;
+  }
+  for(int phase=0;phase<PERF_PHASES;phase++)
+    reset(phase);
+}
+
+PerfCounters::~PerfCounters()
+{
+#ifdef __linux__
+  for(int c=0;c<PERF_COUNTERS;c++)
+    if(fds[c] >= 0)
+      close(fds[c]);
+#endif
+}
+
+/*
+ * Opens the counters as one group led by the cycle counter, so they are
+ * read together. Counters other than cycles the machine lacks are left
+ * out. Returns false if there are none, saying why the first time.
+ */
+bool PerfCounters::open()
+{
+#ifdef __linux__
+  if(isOpen())
+    return true;
+  
+  const unsigned long long configs[PERF_COUNTERS] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+  for(int c=0;c<PERF_COUNTERS;c++)
+  {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = configs[c];
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+    
+    fds[c] = syscall(__NR_perf_event_open, &attr, 0, -1, leader, 0);
+    if(fds[c] < 0)
+    {
+      if(c == PERF_CYCLES)
+      {
+        if(!reported)
+          std::cout << "Hardware counters unavailable: " << strerror(errno) << std::endl;
+        reported = true;
+        return false;
+      }
+      continue;
+    }
+    if(c == PERF_CYCLES)
+      leader = fds[c];
+    slots[c] = opened++;
+  }
+  return true;
+#else
+  if(!reported)
+    std::cout << "Hardware counters unavailable: perf_event_open needs Linux" << std::endl;
+  reported = true;
+  return false;
+#endif
+}
+
+/*
+ * Returns the current counts, all zero if the counters are not open
+ */
+PerfSample PerfCounters::sample() const
+{
+  PerfSample sample;
+  memset(&sample, 0, sizeof(sample));
+#ifdef __linux__
+  if(!isOpen())
+    return sample;
+  
+  unsigned long long group[1 + PERF_COUNTERS];
+  if(read(leader, group, sizeof(group)) < (ssize_t)((1 + opened) * sizeof(group[0])))
+    return sample;
+  for(int c=0;c<PERF_COUNTERS;c++)
+    if(slots[c] >= 0)
+      sample.values[c] = group[1 + slots[c]];
+#endif
+  return sample;
+}
+
+/*
+ * Adds the counts between the two samples to the phase
+ */
+void PerfCounters::add(int phase, const PerfSample &from, const PerfSample &to)
+{
+  for(int c=0;c<PERF_COUNTERS;c++)
+    totals[phase].values[c] = totals[phase].values[c] + (to.values[c] - from.values[c]);
+  samples[phase]++;
+}
+
+void PerfCounters::reset(int phase)
+{
+  memset(&totals[phase], 0, sizeof(totals[phase]));
+  samples[phase] = 0;
+}
+
+/*
+ * Displays the IPC and the misses of every phase counted, per event for
+ * the dispatch phase, per schedule for scheduling and in total otherwise
+ */
+void PerfCounters::display(long events) const
+{
+  if(!isOpen())
+    return;
+  
+  for(int phase=0;phase<PERF_PHASES;phase++)
+  {
+    const PerfSample &total = totals[phase];
+    if(samples[phase] == 0 || total.values[PERF_CYCLES] == 0)
+      continue;
+    
+    double per = 1;
+    const char *unit = "";
+    if(phase == PERF_DISPATCH && events > 0)
+    {
+      per = (double)events;
+      unit = "/Event";
+    }
+    else if(phase == PERF_SCHEDULING)
+    {
+      per = (double)samples[phase];
+      unit = "/Schedule";
+    }
+    
+    std::cout << phaseNames[phase] << " Counters: Cycles: " << total.values[PERF_CYCLES];
+    if(slots[PERF_INSTRUCTIONS] >= 0)
+      std::cout << "\tIPC: " << (double)total.values[PERF_INSTRUCTIONS] / (double)total.values[PERF_CYCLES];
+    if(slots[PERF_CACHE_MISSES] >= 0)
+      std::cout << "\tCache Misses" << unit << ": " << (double)total.values[PERF_CACHE_MISSES] / per;
+    if(slots[PERF_BRANCH_MISSES] >= 0)
+      std::cout << "\tBranch Misses" << unit << ": " << (double)total.values[PERF_BRANCH_MISSES] / per;
+    std::cout << std::endl;
+  }
+}
+
+#endif
@@ -0,0 +1,127 @@
+#ifndef POLICIES_H
+#define POLICIES_H
+
+#include <iostream>       //std::cout
+#include <vector>         //std::vector
+
+#include "Link.h"
+#include "Clique.h"
+#include "EventProfile.h"
+#include "EventTrace.h"
+
+/*
+ * Policies the Simulation event loop is compiled with. Simulation::start()
+ * picks the instantiation for the run's parameters, so none of these are
+ * tested per event and the unused paths compile out.
+ */
+
+/*
+ * Scheduling policies: without FS every MR always has permission and no
+ * link requirements are kept; with FS the requirements on each link are
+ * tracked and SCHEDULE events hand out permission
+ */
+struct NoScheduling
+{
+  static const bool enabled = false;
+};
+
+struct FairScheduling
+{
+  static const bool enabled = true;
+};
+
+/*
+ * Instrumentation policies: SilentTrace does nothing, DebugTrace prints
+ * every event and pauses before each one, ProfileTrace times the handler
+ * of every event into the run's EventProfile, RecordTrace writes every
+ * event to the binary EventTrace
+ */
+struct SilentTrace
+{
+  template <class Sim> static void beforeEvent(Sim &){};
+  static unsigned long long startEvent(){return 0;};
+  static void endEvent(EventProfile &, int, unsigned long long){};
+  static void newPacket(int, int, double){};
+  static void arrived(int, int, double){};
+  static void hop(int, int, int, double){};
+  static void success(int, double){};
+  static void drop(int, int, double){};
+  static void schedule(const std::vector<Link> &, const std::vector<Clique> &, double){};
+  static void permission(int, const Link &, double, double){};
+  static void permissionStart(int, int, double){};
+  static void permissionStop(int, int, double){};
+  static int beginRun(){return 0;};
+  static void record(int, int, double, int, int, int, double){};
+};
+
+struct DebugTrace
+{
+  template <class Sim> static void beforeEvent(Sim &sim)
+  {
+    sim.displayMRs();
+    sim.pause();
+  };
+  static unsigned long long startEvent(){return 0;};
+  static void endEvent(EventProfile &, int, unsigned long long){};
+  
+  static void newPacket(int source, int destination, double now)
+  {std::cout << "  NEW S: " << source << " D: " << destination << " Time: " << now << std::endl;};
+  
+  static void arrived(int source, int destination, double now)
+  {std::cout << "  HOP S: " << source << " D: " << destination << " Time: " << now << std::endl;};
+  
+  static void hop(int source, int neighbour, int destination, double now)
+  {std::cout << "  HOP S: " << source << " to N: " << neighbour << " with D: " << destination << " Time: " << now << std::endl;};
+  
+  static void success(int source, double now)
+  {std::cout << "  SUCCESS: " << source << " Time: " << now << std::endl;};
+  
+  static void drop(int source, int destination, double now)
+  {std::cout << "  DROP S: " << source << " D: " << destination << " Time: " << now << std::endl;};
+  
+  static void schedule(const std::vector<Link> &LS, const std::vector<Clique> &scheduling, double now)
+  {
+    std::cout << "  GEN SCHEDULE: Time: " << now << std::endl;
+  
+    std::cout << "active links: " << std::endl;
+    for(unsigned int x=0;x<LS.size();x++)
+      if(LS[x].getRequirement() > 0)
+        LS[x].display();
+    std::cout << std::endl;
+  
+    std::cout << "scheduling: " << std::endl;
+    for(unsigned int x=0;x<scheduling.size();x++)
+      scheduling[x].display();
+    std::cout << std::endl;
+  };
+  
+  static void permission(int link_id, const Link &link, double start, double stop)
+  {std::cout << "  L: " << link_id << " T: " << start << " - " << stop << ": " << link.getSource() << " & " << link.getDestination() << std::endl;};
+  
+  static void permissionStart(int source, int destination, double now)
+  {std::cout << "  GIVE PERMISSION: " << source << " & " << destination << " Time: " << now << std::endl;};
+  
+  static void permissionStop(int source, int destination, double now)
+  {std::cout << "  STOP PERMISSION: " << source << " & " << destination << " Time: " << now << std::endl;};
+  
+  static int beginRun(){return 0;};
+  static void record(int, int, double, int, int, int, double){};
+};
+
+struct ProfileTrace : SilentTrace
+{
+  static unsigned long long startEvent(){return EventProfile::ticks();};
+  
+  static void endEvent(EventProfile &profile, int type, unsigned long long started)
+  {profile.add(type, EventProfile::ticks() - started);};
+};
+
+struct RecordTrace : SilentTrace
+{
+  static int beginRun(){return EventTrace::beginRun();};
+  
+  static void record(int run, int type, double now, int source, int destination, int packet, double delay)
+  {EventTrace::record(run, type, now, source, destination, packet, delay);};
+};
+
+#endif
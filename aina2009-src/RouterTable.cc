@@ -0,0 +1,97 @@
+#ifndef ROUTERTABLE_CC
+#define ROUTERTABLE_CC
+
+#include "RouterTable.h"
+#include <cmath>
+#include <limits>
+
+/*
+ * Removes every MR from the table
+ */
+void RouterTable::clear()
+{
+  x.clear(); y.clear();
+  gateway.clear(); permission.clear(); busy.clear();
+}
+
+void RouterTable::reserve(size_t n)
+{
+  x.reserve(n); y.reserve(n);
+  gateway.reserve(n/64+1); permission.reserve(n/64+1); busy.reserve(n/64+1);
+}
+
+/*
+ * Adds a new MR at (newX, newY) with no permission,
+ * and returns its id
+ */
+int RouterTable::addRouter(double newX, double newY)
+{
+  int id = (int)x.size();
+  x.push_back(newX);
+  y.push_back(newY);
+  
+  /* start a new word of flags every 64 routers */
+  if((id & 63) == 0)
+  {
+    gateway.push_back(0);
+    permission.push_back(0);
+    busy.push_back(0);
+  }
+  return id;
+}
+
+/*
+ * Gives (or takes away) permission to every MR a whole word at a time
+ */
+void RouterTable::setAllPermissions(bool p)
+{
+  unsigned long long fill = p ? ~0ULL : 0ULL;
+  for(unsigned int w=0; w<permission.size(); w++)
+    permission[w] = fill;
+}
+
+/*
+ * Gives every MR permission p and marks them all as idle
+ */
+void RouterTable::resetRunState(bool p)
+{
+  setAllPermissions(p);
+  busy.assign(busy.size(), 0);
+}
+
+/*
+ * Turns every gateway back into a plain MR
+ */
+void RouterTable::clearGateways()
+{
+  gateway.assign(gateway.size(), 0);
+}
+
+/*
+ * Returns the id of the MR closest to (px, py) which is within range,
+ * or -1 if there is none. The distances are computed in one straight
+ * pass over the x and y arrays, which the compiler can vectorize, before
+ * the (cheap) scan for the minimum.
+ */
+int RouterTable::nearest(double px, double py, double range)
+{
+  unsigned int n = x.size();
+  distances.resize(n);
+  const double *xs = x.data();
+  const double *ys = y.data();
+  double *d = distances.data();
+  
+  for(unsigned int c=0; c<n; c++)
+    d[c] = sqrt((xs[c]-px)*(xs[c]-px)+(ys[c]-py)*(ys[c]-py));
+  
+  double minDist=std::numeric_limits<double>::max();
+  int minID=-1;
+  for(unsigned int c=0; c<n; c++)
+  {
+    if(d[c] <= range && d[c] < minDist)
+    { minDist = d[c]; minID = c; }
+  }
+  return minID;
+}
+
+#endif
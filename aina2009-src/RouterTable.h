@@ -0,0 +1,57 @@
+#ifndef ROUTERTABLE_H
+#define ROUTERTABLE_H
+
+#include <vector>         //std::vector
+#include <cstddef>        //size_t
+
+class MeshRouter;
+
+/*
+ * Structure-of-arrays store for all of the MRs in a Simulation. Each
+ * field lives in its own contiguous array indexed by router id, and the
+ * boolean flags are packed 64 routers to a word, so a loop over one
+ * field (positions, permissions) only touches that field.
+ * MeshRouter is a thin view onto one entry of the table.
+ */
+class RouterTable
+{
+  public:
+  /* Mutators */
+  void clear();
+  void reserve(size_t n);
+  int addRouter(double newX, double newY);
+  void setAllPermissions(bool p);
+  void resetRunState(bool p);
+  void clearGateways();
+  
+  /* Accessors */
+  unsigned int size() const {return x.size();};
+  MeshRouter operator[](int router_id);
+  
+  /* Kernels */
+  int nearest(double px, double py, double range);
+  
+  /* Packed flags */
+  static bool testBit(const std::vector<unsigned long long> &bits, int router_id)
+  {return (bits[router_id >> 6] >> (router_id & 63)) & 1;};
+  static void setBit(std::vector<unsigned long long> &bits, int router_id, bool value)
+  {
+    unsigned long long mask = 1ULL << (router_id & 63);
+    if(value)
+      bits[router_id >> 6] |= mask;
+    else
+      bits[router_id >> 6] &= ~mask;
+  };
+  
+  /* static geometry */
+  std::vector<double> x, y;
+  std::vector<unsigned long long> gateway;
+  
+  /* per-run state */
+  std::vector<unsigned long long> permission, busy;
+  
+  private:
+  std::vector<double> distances;  //scratch space for nearest()
+};
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef RUNSTATE_CC
+#define RUNSTATE_CC
+
+#include "RunState.h"
+
+/*
+ * Empties the event queue, wait lists and packet queues and zeroes the
+ * statistics, ready for a new run over num_routers MRs
+ */
+void RunState::reset(int num_routers, int queueCapacity)
+{
+  EQ.clear();
+  waiting.resize(num_routers);
+  queues.resize(num_routers, queueCapacity);
+  packets.resize(num_routers * queueCapacity);
+  
+  packet_counter=0;
+  success_counter=0;
+  drop_counter=0;
+  high_delay=0;
+  low_delay=0;
+  drop_delay=0;
+  progress=0;
+  schedule_counter=0;
+  budget_hits=0;
+  search_saved=0;
+  schedule_gap=0;
+  events=0;
+  peak_queue=0;
+  schedule_seconds=0;
+  profile.reset();
+  delays.reset(num_routers);
+}
+
+#endif
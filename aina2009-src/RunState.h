@@ -0,0 +1,45 @@
+#ifndef RUNSTATE_H
+#define RUNSTATE_H
+
+#include "EventQueue.h"
+#include "WaitList.h"
+#include "PacketPool.h"
+#include "PacketQueue.h"
+#include "EventProfile.h"
+#include "StreamStats.h"
+
+/*
+ * Everything a single Simulation run changes apart from the permission
+ * and busy flags in the RouterTable and the requirements on the links:
+ * the pending events, the packets parked and queued at each MR, and the
+ * statistics. reset() empties it in place, keeping the memory from the
+ * previous run, so repeats do not reallocate.
+ */
+class RunState
+{
+  public:
+  void reset(int num_routers, int queueCapacity);
+  
+  EventQueue EQ;
+  WaitList waiting;
+  PacketPool packets;
+  PacketQueue queues;
+  EventProfile profile;   //filled only by the ProfileTrace policy
+  DelayStats delays;      //of the packets delivered and dropped
+  WarmupDetector warmup;  //of the delivered delays, filled only with WARMUP
+  int run;                //number of the run in the EventTrace, filled only by RecordTrace
+  
+  /* statistic variables */
+  int packet_counter, success_counter, drop_counter, progress;
+  int schedule_counter, budget_hits;  //budgeted schedules and how many ran out of budget
+  int search_saved;       //HOPDELAYs taken off the schedules by the local search
+  double schedule_gap;    //sum over the schedules of (length - lower bound) / lower bound
+  long events;            //events handled
+  unsigned int peak_queue;  //most events pending at once
+  double schedule_seconds;  //wall-clock time spent building schedules
+  double high_delay;      //over-estimate using dropped delays
+  double low_delay;       //under-estimate using only success delays
+  double drop_delay;      //of the dropped packets only
+};
+
+#endif
@@ -0,0 +1,122 @@
+/*
+ * Compares the scheduling engines on hexagonal lattices of growing size:
+ * for random link requirements it reports the frame length each engine
+ * produces (in HOPDELAYs, against the lower bound) and its time per
+ * schedule. The clique engine runs under an operation budget so that the
+ * large lattices finish; the frames where it ran out are counted. The
+ * "+ls" rows add the local search post-pass to the engine before them
+ * (the time is for the pass alone).
+ *
+ * usage: ./schedule-bench [schedules per size] [clique operation budget] [local search iterations]
+ */
+
+#include <iostream>       //std::cout
+#include <cstdlib>        //atoi, atol, srand48, drand48
+#include <chrono>         //std::chrono::steady_clock
+#include <vector>         //std::vector
+
+#include "RouterTable.h"
+#include "Lattice.h"
+#include "Link.h"
+#include "Matrix.h"
+#include "Coloring.h"
+#include "LocalSearch.h"
+#include "ScheduleBudget.h"
+
+/* totals for one engine over all the schedules of one lattice size */
+struct EngineResult
+{
+  EngineResult(){length=0; seconds=0; budgetHits=0;};
+  long length;
+  double seconds;
+  int budgetHits;
+};
+
+static void report(const char *engine, const EngineResult &r, int schedules, long bound)
+{
+  std::cout << "  " << engine << "\tAvg Length: " << (double)r.length / schedules
+            << "\tGap: " << (double)(r.length - bound) / (double)bound * 100.0 << "%"
+            << "\tus/schedule: " << r.seconds / schedules * 1e6;
+  if(r.budgetHits > 0)
+    std::cout << "\tBudget Hits: " << r.budgetHits;
+  std::cout << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+  int schedules = argc > 1 ? atoi(argv[1]) : 20;
+  long budgetOps = argc > 2 ? atol(argv[2]) : 200000;
+  int searchIterations = argc > 3 ? atoi(argv[3]) : 10000;
+  const double sizes[] = {80, 120, 160, 240, 320, 480};
+  const double range = 120;
+  
+  srand48(7);
+  
+  for(unsigned int s=0;s<sizeof(sizes)/sizeof(sizes[0]);s++)
+  {
+    RouterTable MR;
+    Lattice lattice;
+    lattice.generateHexagonal(sizes[s], sizes[s], range, MR);
+    
+    std::vector <Link> LS;
+    for(unsigned int x=0;x<MR.size();x++)
+      for(const int *n = lattice.neighboursBegin(x); n != lattice.neighboursEnd(x); n++)
+        LS.push_back(Link(LS.size(), x, *n));
+    
+    EngineResult clique, cliqueSearch, dsatur, dsaturSearch, lrf;
+    long bound=0;
+    for(int i=0;i<schedules;i++)
+    {
+      /* about half of the links need 1 to 4 turns */
+      for(unsigned int l=0;l<LS.size();l++)
+        LS[l].setRequirement(drand48() < 0.5 ? 1 + (int)(drand48() * 4) : 0);
+      
+      Matrix CM(LS);
+      bound = bound + CM.getLowerBound();
+      
+      std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+      ScheduleBudget budget(budgetOps, 0);
+      std::vector <Clique> scheduling = CM.generateScheduling(budget);
+      std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+      clique.length = clique.length + CM.getLength(scheduling);
+      clique.seconds = clique.seconds + std::chrono::duration<double>(t1 - t0).count();
+      if(budget.exhausted())
+        clique.budgetHits++;
+      
+      LocalSearch pass(LS);
+      t0 = std::chrono::steady_clock::now();
+      pass.improve(scheduling, searchIterations);
+      t1 = std::chrono::steady_clock::now();
+      cliqueSearch.length = cliqueSearch.length + CM.getLength(scheduling);
+      cliqueSearch.seconds = cliqueSearch.seconds + std::chrono::duration<double>(t1 - t0).count();
+      
+      Coloring byDsatur(LS, true);
+      t0 = std::chrono::steady_clock::now();
+      scheduling = byDsatur.generateScheduling();
+      t1 = std::chrono::steady_clock::now();
+      dsatur.length = dsatur.length + CM.getLength(scheduling);
+      dsatur.seconds = dsatur.seconds + std::chrono::duration<double>(t1 - t0).count();
+      
+      t0 = std::chrono::steady_clock::now();
+      pass.improve(scheduling, searchIterations);
+      t1 = std::chrono::steady_clock::now();
+      dsaturSearch.length = dsaturSearch.length + CM.getLength(scheduling);
+      dsaturSearch.seconds = dsaturSearch.seconds + std::chrono::duration<double>(t1 - t0).count();
+      
+      Coloring byRequirement(LS, false);
+      t0 = std::chrono::steady_clock::now();
+      scheduling = byRequirement.generateScheduling();
+      t1 = std::chrono::steady_clock::now();
+      lrf.length = lrf.length + CM.getLength(scheduling);
+      lrf.seconds = lrf.seconds + std::chrono::duration<double>(t1 - t0).count();
+    }
+    
+    std::cout << "MRs: " << MR.size() << "\tLinks: " << LS.size() << "\tAvg Lower Bound: " << (double)bound / schedules << std::endl;
+    report("clique", clique, schedules, bound);
+    report("+ls", cliqueSearch, schedules, bound);
+    report("dsatur", dsatur, schedules, bound);
+    report("+ls", dsaturSearch, schedules, bound);
+    report("lrf", lrf, schedules, bound);
+  }
+  return 0;
+}
@@ -0,0 +1,46 @@
+#ifndef SCHEDULEBUDGET_CC
+#define SCHEDULEBUDGET_CC
+
+#include "ScheduleBudget.h"
+
+/* the clock is only read this often, it costs more than an operation */
+#define CLOCK_INTERVAL 1024
+
+/*
+ * An unlimited budget
+ */
+ScheduleBudget::ScheduleBudget()
+{
+  ops=0; maxOps=0; maxSeconds=0; hit=false;
+}
+
+ScheduleBudget::ScheduleBudget(long newMaxOps, double newMaxSeconds)
+{
+  ops=0; maxOps=newMaxOps; maxSeconds=newMaxSeconds; hit=false;
+  if(maxSeconds > 0)
+    started = std::chrono::steady_clock::now();
+}
+
+/*
+ * Charges the given number of operations, returns false once the
+ * budget is exhausted
+ */
+bool ScheduleBudget::spend(long n)
+{
+  if(hit)
+    return false;
+  
+  long before = ops;
+  ops = ops + n;
+  if(maxOps > 0 && ops > maxOps)
+    hit = true;
+  else if(maxSeconds > 0 && before / CLOCK_INTERVAL != ops / CLOCK_INTERVAL)
+  {
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - started;
+    if(elapsed.count() > maxSeconds)
+      hit = true;
+  }
+  return !hit;
+}
+
+#endif
@@ -0,0 +1,29 @@
+#ifndef SCHEDULEBUDGET_H
+#define SCHEDULEBUDGET_H
+
+#include <chrono>         //std::chrono::steady_clock
+
+/*
+ * Limits the work done building one schedule, either in operations
+ * (unique checks and sub-cliques generated) or in wall-clock seconds.
+ * A limit of 0 means unlimited. Once it is exhausted it stays exhausted,
+ * and the scheduler is expected to return the best schedule it has.
+ */
+class ScheduleBudget
+{
+  public:
+  ScheduleBudget();
+  ScheduleBudget(long maxOps, double maxSeconds);
+  
+  bool spend(long ops);
+  bool exhausted() const {return hit;};
+  long getOps() const {return ops;};
+  
+  private:
+  long ops, maxOps;
+  double maxSeconds;
+  bool hit;
+  std::chrono::steady_clock::time_point started;
+};
+
+#endif
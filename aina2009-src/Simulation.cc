@@ -13,64 +13,67 @@
 
 #include "Simulation.h"
 #include <stdio.h>
+#include <chrono>         //std::chrono::steady_clock
+
+Simulation::Simulation(const Parameters &newParams)
+{
+  params = newParams;
+  seed(time(NULL));
+  now=0;
+  if(params.perf_counters)
+    counters.open();
+}
 
 /*
- * Main Function
+ * Restarts the random numbers of this Simulation from the given seed.
+ * Every Simulation has its own stream so that replications can run on
+ * several threads at once. It follows srand48, so one seed gives the
+ * same run as the global drand48 stream did.
  */
-int main()
+void Simulation::seed(long value)
 {
-  double totalDelay = 0;
-  double totalPacketDeliveryRatio=0;
-  int numMRs = 0;
-  int numGWs = 0;
-  
-  for(int repeat=0; repeat < REPEATS; repeat++)
-  {
-    Simulation sim;
-  
-    /* Initialize the Simulator */
-    sim.generateHexagonalTopology();
+  randomState[0] = 0x330E;
+  randomState[1] = (unsigned short)(value & 0xFFFF);
+  randomState[2] = (unsigned short)((value >> 16) & 0xFFFF);
+}
 
-    std::cout << "MR: " << sim.getNumMRs() << std::endl;
-  
-    if(FS_ENABLED)
-    { sim.generateLinks(); }
-  
-    sim.start();
-    
-    /* Stats */
-    totalDelay = totalDelay + sim.getAvgDelay();
-    totalPacketDeliveryRatio = totalPacketDeliveryRatio + sim.getPacketDeliveryRatio();
-    numMRs = sim.getNumMRs();
-    numGWs = sim.getNumGWs();
-    
-    /* Display Statistics for each run*/
-    sim.displayStats();
-    
-    /* Progress */
-    if(DISPLAY_PROGRESS)
-    {
-      std::cout << "Progress: Run " << repeat+1 << " out of " << REPEATS 
-<< std::endl;
-    }
-  }
-  std::cout << "Successfully ran " << REPEATS << " runs. Stats: " << std::endl;
-  std::cout << "AVG DELAY: " << totalDelay / (double)REPEATS << std::endl;
-  std::cout << "AVG PDR: " << totalPacketDeliveryRatio / (double)REPEATS << std::endl;
-  std::cout << "MRs: " << numMRs << " GWs: " << numGWs << std::endl;
-  return 0;
+/*
+ * Seeds replication r of a sequence started from base. The pair is
+ * hashed (splitmix64) into all 48 bits of the state, so the streams of
+ * neighbouring replications are not shifted copies of each other.
+ */
+void Simulation::seedReplication(long base, int replication)
+{
+  unsigned long long z = (unsigned long long)base + 0x9E3779B97F4A7C15ULL * (unsigned long long)(replication + 1);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  z = z ^ (z >> 31);
+  randomState[0] = (unsigned short)(z & 0xFFFF);
+  randomState[1] = (unsigned short)((z >> 16) & 0xFFFF);
+  randomState[2] = (unsigned short)((z >> 32) & 0xFFFF);
 }
 
-Simulation::Simulation()
+/*
+ * Prepares for a new run over the same MRs and links: picks new GWs,
+ * clears the permissions, link requirements, events and queues and zeroes
+ * the statistics. Containers keep their memory from the previous run.
+ */
+void Simulation::reset()
 {
-  srand48(time(NULL));
   now=0;
-  packet_counter=0;
-  success_counter=0;
-  drop_counter=0;
-  high_delay=0;
-  low_delay=0;
-  progress=0;
+  state.reset(MR.size(), params.queue_capacity);
+  state.warmup.reset(params.steady_precision);
+  counters.reset(PERF_DISPATCH);
+  counters.reset(PERF_SCHEDULING);
+  state.EQ.setResolution(params.ticks_per_second);
+  
+  MR.resetRunState(!params.fs_enabled);
+  for(unsigned int l=0;l<LS.size();l++)
+    LS[l].setRequirement(0);
+  
+  MR.clearGateways();
+  GW.clear();
+  generateGWs();
 }
 
 /*
@@ -78,78 +81,122 @@ Simulation::Simulation()
  */
 void Simulation::start()
 {
-  std::cout << "Starting Simulation..." << std::endl;
-    
+  (this->*selectRun())();
+}
+
+/*
+ * Returns the main loop compiled for the scheduling and instrumentation
+ * policies the parameters ask for
+ */
+Simulation::RunFunction Simulation::selectRun()
+{
+  static const RunFunction runs[2][4] = {
+    {&Simulation::run<NoScheduling, SilentTrace>, &Simulation::run<NoScheduling, DebugTrace>, &Simulation::run<NoScheduling, ProfileTrace>, &Simulation::run<NoScheduling, RecordTrace>},
+    {&Simulation::run<FairScheduling, SilentTrace>, &Simulation::run<FairScheduling, DebugTrace>, &Simulation::run<FairScheduling, ProfileTrace>, &Simulation::run<FairScheduling, RecordTrace>}
+  };
+  int trace = 0;
+  if(params.debugging)
+    trace = 1;
+  else if(EventTrace::enabled())
+    trace = 3;
+  else if(params.profile_events)
+    trace = 2;
+  return runs[params.fs_enabled][trace];
+}
+
+template <class Scheduling, class Trace>
+void Simulation::run()
+{
+  if(params.display_progress)
+    std::cout << "Starting Simulation..." << std::endl;
+  
+  state.run = Trace::beginRun();
   generateNewPacket();
   
   /* Push a SCHEDULE event */
-  if(FS_ENABLED)
+  if(Scheduling::enabled)
   {
     Event nschedule(now, EMPTY, EMPTY, SCHEDULE);
-    EQ.push(nschedule);
+    state.EQ.push(nschedule);
   }
   
+  /* the dispatch counters run from here to the end, except during SCHEDULE events */
+  PerfSample dispatchStarted = counters.sample();
+  
   /* Main Simulation Loop */
-  while(!EQ.empty() && packet_counter < NUMPACKETS && now < END)
+  while(!state.EQ.empty() && state.packet_counter < params.num_packets && now < params.end && !state.warmup.isSteady())
   {
     /* Get the most recent event off the queue */
-    Event E = EQ.top(); EQ.pop();
+    if(state.EQ.size() > state.peak_queue)
+      state.peak_queue = state.EQ.size();
+    Event E = state.EQ.top(); state.EQ.pop();
     now = E.getTime();
+    state.events++;
     
-    if(DEBUGGING)
-    {
-      displayMRs();
-      pause();
-    }
+    Trace::beforeEvent(*this);
+    unsigned long long handlerStarted = Trace::startEvent();
     
     switch(E.getType())
     {
       case NEW:
-        p_new(E);
+        p_new<Scheduling, Trace>(E);
       break;
       
       case HOP:
-        p_hop(E);
+        p_hop<Scheduling, Trace>(E);
       break;
       
       case SUCCESS:
-        p_success(E);
+        p_success<Scheduling, Trace>(E);
       break;
       
       case DROP:
-        p_drop(E);
+        p_drop<Scheduling, Trace>(E);
       break;
       
       case SCHEDULE:
-        p_schedule(E);
+      {
+        std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now();
+        PerfSample scheduleStarted = counters.sample();
+        counters.add(PERF_DISPATCH, dispatchStarted, scheduleStarted);
+        p_schedule<Scheduling, Trace>(E);
+        dispatchStarted = counters.sample();
+        counters.add(PERF_SCHEDULING, scheduleStarted, dispatchStarted);
+        state.schedule_seconds = state.schedule_seconds + std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+      }
       break;
       
       case PERMISSION_START:
-        p_start(E);
+        p_start<Scheduling, Trace>(E);
       break;
       
       case PERMISSION_STOP:
-        p_stop(E);
+        p_stop<Scheduling, Trace>(E);
       break;
       
       default:
         std::cout << "Unrecognized event type!" << std::endl;
         exit(255);
     }
+    Trace::endEvent(state.profile, E.getType(), handlerStarted);
     
     /* Generate new packets while the Simulation should still be running */
-    if(packet_counter < NUMPACKETS && now < END)
+    if(state.packet_counter < params.num_packets && now < params.end)
       generateNewPacket();
     
     /* Display Progress of Simulation */
-    if(DISPLAY_PROGRESS)
-      if((int)(((double)packet_counter / (double)NUMPACKETS)*100.0) != progress)
+    if(params.display_progress)
+      if((int)(((double)state.packet_counter / (double)params.num_packets)*100.0) != state.progress)
       {
-        progress = (int)(((double)packet_counter / (double)NUMPACKETS)*100.0);
-        std::cout << "Progress: " << progress << "% \tTime: " << now << "\tPackets: " << packet_counter << std::endl;
+        state.progress = (int)(((double)state.packet_counter / (double)params.num_packets)*100.0);
+        std::cout << "Progress: " << state.progress << "% \tTime: " << now << "\tPackets: " << state.packet_counter << std::endl;
       }
   }
-  std::cout << "Simulation Complete." << std::endl;
+  counters.add(PERF_DISPATCH, dispatchStarted, counters.sample());
+  if(params.warmup)
+    state.warmup.update();
+  if(params.display_progress)
+    std::cout << "Simulation Complete." << std::endl;
 }
 
 /*
@@ -158,61 +205,35 @@ void Simulation::start()
  */
 void Simulation::generateHexagonalTopology()
 {
+  Timeline::Span span("topology");
+  PerfSample started = counters.sample();
   std::cout << "Generating the Topology...";
   
-  //helpful variables
-  double x=0, y=0;
-  bool indentRow = true;
-  int currentID=0;
-  
-  /* calculate the distances in x and y direction that MRs will be spread apart */
-  double xDist = (double)3/4 * (double)MR_RANGE;
-  double yDist = xDist;
-  
-  
-  //add rows of MRs
-  while(y < MAX_Y + yDist)
-  {
-    if(indentRow)
-    { x=0; indentRow = false;}
-    else
-    { x=xDist/2; indentRow = true;}
-    
-    //add cols of MRs
-    while(x < MAX_X + xDist)
-    {
-      MeshRouter temp(currentID, x, y);
-      if(!FS_ENABLED)
-        temp.setPermission(true);
-      MR.push_back(temp);
-      currentID++;
-      x=x+xDist;
-    }
-    y=y+yDist;
-  }
-  
-  generateNeighbours();
-  generateGWs();
+  /* routers and their neighbours come straight from the lattice layout */
+  lattice.generateHexagonal(params.max_x, params.max_y, params.mr_range, MR);
+  counters.add(PERF_TOPOLOGY, started, counters.sample());
     
   std::cout << "complete." << std::endl;
 }
 
 void Simulation::generateLinks()
 {
+  Timeline::Span span("links");
+  PerfSample started = counters.sample();
   std::cout << "Generating links...";
   
   int currentID = 0;
   
   for(unsigned int x=0;x<MR.size();x++)
   {
-    std::vector<int> currentNeighbours = MR[x].getNeighbours();
-    for(unsigned int n=0; n<currentNeighbours.size(); n++)
+    for(const int *n = lattice.neighboursBegin(x); n != lattice.neighboursEnd(x); n++)
     {
-      Link temp(currentID, MR[x].getID(), currentNeighbours[n]);
+      Link temp(currentID, MR[x].getID(), *n);
       currentID++;
       LS.push_back(temp);
     }
   }
+  counters.add(PERF_TOPOLOGY, started, counters.sample());
   
   std::cout << "done." << std::endl;
 }
@@ -222,7 +243,7 @@ void Simulation::generateLinks()
  * Supports both uplink and downlink packets.
  * 
  * For just uplink set UPDOWN_RATIO = 1
- * For just downlink set UPDOWN_RATIO = 0;
+ * For just downlink set UPDOWN_RATIO = 0
  */
 void Simulation::generateNewPacket()
 {
@@ -231,14 +252,14 @@ void Simulation::generateNewPacket()
    * Uplink: from MCs to GWs
    * Downlink: from GWs to MCs
    */
-  double chance = drand48();
-  double x = drand48() * MAX_X;
-  double y = drand48() * MAX_Y;
+  double chance = uniform();
+  double x = uniform() * params.max_x;
+  double y = uniform() * params.max_y;
   
   int source=-1; int destination=-1;
   
   //uplink
-  if(chance < UPDOWN_RATIO)
+  if(chance < params.updown_ratio)
   {
     source = nearestMeshRouter(x,y);
     destination = MR[nearestGW(source)].getID();
@@ -250,17 +271,27 @@ void Simulation::generateNewPacket()
     source = MR[nearestGW(destination)].getID();
   }
   
-  double time = now + (-MEAN * log(drand48()));
+  double time = now + (-params.mean * log(uniform()));
   Event temp(time, source, destination, NEW);
-  EQ.push(temp);
+  state.EQ.push(temp);
 }
 
 void Simulation::displayMRs()
 {
   std::cout << "Displaying Mesh Routers: " << std::endl;
   for(unsigned int x=0;x<MR.size();x++)
+  {
     MR[x].display();
-  std::cout << "Success: " << success_counter << "\tDropped: " << drop_counter << std::endl;
+    if(!state.queues.empty(x))
+    {
+      std::cout << "  Queue:";
+      for(int q=0;q<state.queues.size(x);q++)
+        std::cout << " " << state.packets[state.queues.at(x, q)].destination;
+      std::cout << std::endl;
+    }
+    displayNeighbours(x);
+  }
+  std::cout << "Success: " << state.success_counter << "\tDropped: " << state.drop_counter << std::endl;
 }
 
 void Simulation::displayLinks()
@@ -272,37 +303,44 @@ void Simulation::displayLinks()
 
 void Simulation::displayStats()
 {
-  if(FS_ENABLED)
+  if(params.fs_enabled)
     std::cout << "FS ENABLED" << std::endl;
   else
     std::cout << "NO FS" << std::endl;
   std::cout << "Number of MRs: " << MR.size() << "\tNumber of Links: " << LS.size() << "\t# GWs: " << GW.size() << std::endl;
-  std::cout << "Pkts: " << packet_counter << "\tSuccess: " << success_counter << "\tDropped: " << drop_counter << "\tS%: " << (double)((double)success_counter / (double)packet_counter) * 100.0 << std::endl;
-  std::cout << "HOPDELAY: " << HOPDELAY << "\t\tMEAN: " << MEAN << std::endl;
-  std::cout << "Ttl HDelay: " << high_delay << "\tTtl LDelay: " << low_delay << std::endl;
-  std::cout << "Avg HDelay: " << (double)high_delay / (double)packet_counter << "Avg LDelay: " << (double)low_delay / (double)packet_counter << std::endl;
+  std::cout << "Pkts: " << state.packet_counter << "\tSuccess: " << state.success_counter << "\tDropped: " << state.drop_counter << "\tS%: " << (double)((double)state.success_counter / (double)state.packet_counter) * 100.0 << std::endl;
+  std::cout << "HOPDELAY: " << params.hop_delay << "\t\tMEAN: " << params.mean << std::endl;
+  std::cout << "Ttl HDelay: " << state.high_delay << "\tTtl LDelay: " << state.low_delay << std::endl;
+  std::cout << "Avg Delay: " << getAvgDelay() << "\tAvg Drop Delay: " << getAvgDropDelay() << std::endl;
+  if(params.local_search > 0)
+    std::cout << "Local Search Saved: " << state.search_saved << " HOPDELAYs" << std::endl;
+  if(state.schedule_counter > 0)
+    std::cout << "Schedules: " << state.schedule_counter << "\tBudget Hits: " << state.budget_hits << "\tAvg Gap: " << state.schedule_gap / (double)state.schedule_counter * 100.0 << "%" << std::endl;
+  state.delays.display();
+  if(params.warmup)
+    state.warmup.display();
+  if(params.profile_events)
+    state.profile.display();
+  counters.display(state.events);
 }
 
 /* ---- Private Functions ---- */
 
 /*
- * Generates all possible neighbours for every MR in the topology
- * Two MRs are neighbours if they are within MR_RANGE specified in the
- * Simulation parameters set by Simulation.h
+ * Displays the neighbours of a MR on one line, marking it if it is a GW
  */
-void Simulation::generateNeighbours()
+void Simulation::displayNeighbours(int router_id)
 {
-  for(unsigned int currentMR=0; currentMR < MR.size(); currentMR++)
+  std::cout << "\tNeighbours: ";
+  for(const int *n = lattice.neighboursBegin(router_id); n != lattice.neighboursEnd(router_id); n++)
   {
-    for(unsigned int potentialNeighbour=0; potentialNeighbour < MR.size(); potentialNeighbour++)
-    {
-      if(currentMR != potentialNeighbour)
-      {
-        if(MR[currentMR].distance(MR[potentialNeighbour]) < double(MR_RANGE))
-          MR[currentMR].addNeighbour(MR[potentialNeighbour].getID());
-      }
-    }
+    std::cout << *n;
+    if(n+1 != lattice.neighboursEnd(router_id))
+      std::cout << ",";
   }
+  if(MR[router_id].isGateway())
+    std::cout << "\tGW";
+  std::cout << std::endl;
 }
 
 /*
@@ -311,17 +349,17 @@ void Simulation::generateNeighbours()
  */
 void Simulation::generateGWs()
 {
-  if(MR.size() < NUM_GWS)
+  if((int)MR.size() < params.num_gws)
   {
     std::cout << "Error you have specified more GWs than there are MRs in the simulation. You may fix this by changing the MAX_X and MAX_Y or the NUM_GWS" << std::endl;
     exit(255);
   }
   
-  for(int x=0;x<NUM_GWS;x++)
+  for(int x=0;x<params.num_gws;x++)
   {
-    int gw = (int)(drand48()*MR.size());
+    int gw = (int)(uniform()*MR.size());
     while(MR[gw].isGateway())
-      gw = (int)(drand48()*MR.size());
+      gw = (int)(uniform()*MR.size());
     MR[gw].setGateway();
     GW.push_back(MR[gw].getID());
   }
@@ -332,17 +370,9 @@ void Simulation::generateGWs()
  */
 int Simulation::nearestMeshRouter(double x, double y)
 {
-  double minDist=std::numeric_limits<double>::max();
-  int minID=std::numeric_limits<int>::max();
-  
-  for(unsigned int c=0;c<MR.size();c++)
-  {
-    double distance = sqrt((MR[c].getX()-x)*(MR[c].getX()-x)+(MR[c].getY()-y)*(MR[c].getY()-y));
-    if(distance <= double(MC_RANGE) && distance < minDist)
-    { minDist = distance; minID = c; }
-  }
+  int minID = MR.nearest(x, y, params.mc_range);
   
-  if(minID == std::numeric_limits<int>::max())
+  if(minID == -1)
   {
     std::cout << "Error, could not associate the new packet with a MR." <<
       " You may need to adjust your ranges because there are dead spots in the network coverage." << std::endl;
@@ -385,11 +415,10 @@ int Simulation::nearestNeighbour(unsigned int router_id, int destination)
 {
   double minDist=std::numeric_limits<double>::max();
   int minID=std::numeric_limits<int>::max();
-  std::vector<int> neighbours = MR[router_id].getNeighbours();
   
-  for(unsigned int n=0; n<neighbours.size(); n++)
+  for(const int *n = lattice.neighboursBegin(router_id); n != lattice.neighboursEnd(router_id); n++)
   {
-    int neighbour = neighbours[n];
+    int neighbour = *n;
     double distance = sqrt((MR[neighbour].getX()-MR[destination].getX())*(MR[neighbour].getX()-MR[destination].getX())+(MR[neighbour].getY()-MR[destination].getY())*(MR[neighbour].getY()-MR[destination].getY()));
     if(distance < minDist)
     { minDist = distance; minID = neighbour; }
@@ -420,246 +449,389 @@ int Simulation::findLink(int source, int destination)
   return -1;
 }
 
+/*
+ * Try to guess at which links will be used based on the closest
+ * neighbour, and change the requirement all the way between them and the
+ * destination
+ */
+void Simulation::changePathRequirement(int source, int destination, int change)
+{
+  int tempsource = source;
+
+  while(tempsource!=destination)
+  {
+    int neighbour = nearestNeighbour(tempsource, destination);
+    int l = findLink(tempsource, neighbour);
+    LS[l].setRequirement(LS[l].getRequirement()+change);
+    tempsource = neighbour;
+  }
+}
+
+/*
+ * Returns the scheduling for the current link requirements from the
+ * engine given by SCHEDULER, shortened by the local search when
+ * LOCAL_SEARCH is set
+ */
+std::vector <Clique> Simulation::generateScheduling()
+{
+  Timeline::Span span("schedule");
+  std::vector <Clique> scheduling;
+  if(params.scheduler == DSATUR_SCHEDULER || params.scheduler == LRF_SCHEDULER)
+  {
+    Timeline::Span coloringSpan("colouring");
+    Coloring engine(LS, params.scheduler == DSATUR_SCHEDULER);
+    scheduling = engine.generateScheduling();
+  }
+  else if(params.scheduler != CLIQUE_SCHEDULER)
+  {
+    std::cout << "Error, unknown SCHEDULER: " << params.scheduler << std::endl;
+    exit(255);
+  }
+  else if(params.schedule_ops > 0 || params.schedule_time > 0)
+    scheduling = generateBudgetedScheduling();
+  else
+  {
+    Matrix CM(LS);
+    scheduling = CM.generateScheduling();
+  }
+  
+  if(params.local_search > 0)
+  {
+    Timeline::Span searchSpan("local search");
+    LocalSearch pass(LS);
+    state.search_saved = state.search_saved + pass.improve(scheduling, params.local_search);
+  }
+  return scheduling;
+}
+
+/*
+ * Builds a schedule within SCHEDULE_OPS/SCHEDULE_TIME: a DSATUR
+ * schedule to start with, then the clique scheduling for as long as the
+ * budget lasts, keeping whichever is shorter. Records whether the budget
+ * ran out and how far the result is from the lower bound.
+ */
+std::vector <Clique> Simulation::generateBudgetedScheduling()
+{
+  Matrix CM(LS);
+  int bound = CM.getLowerBound();
+  if(bound == 0)
+    return std::vector <Clique>();
+  
+  ScheduleBudget budget(params.schedule_ops, params.schedule_time);
+  std::vector <Clique> scheduling;
+  {
+    Timeline::Span coloringSpan("colouring");
+    Coloring seed(LS, true);
+    scheduling = seed.generateScheduling();
+  }
+  std::vector <Clique> improved = CM.generateScheduling(budget);
+  
+  int length = CM.getLength(scheduling);
+  if(CM.getLength(improved) < length)
+  {
+    scheduling.swap(improved);
+    length = CM.getLength(scheduling);
+  }
+  
+  state.schedule_counter++;
+  if(budget.exhausted())
+    state.budget_hits++;
+  state.schedule_gap = state.schedule_gap + (double)(length - bound) / (double)bound;
+  return scheduling;
+}
+
 /*
  * Handle a packet from MC to MR
  */
-void Simulation::p_new(Event E)
+template <class Scheduling, class Trace>
+void Simulation::p_new(const Event &E)
 {
   int source = E.getSource();
   int destination = E.getDestination();
   
-  if(DEBUGGING)
-    std::cout << "  NEW S: " << source << " D: " << destination << " Time: " << now << std::endl;
+  Trace::newPacket(source, destination, now);
     
-  if(!MR[source].isBusy() && MR[source].getBuffer() == EMPTY)
+  if(!state.queues.full(source))
   {
-    packet_counter++;
-    MR[source].setBuffer(destination);
-  
-    /* 
-     * try to guess at which links will be used
-     * based on the closest neighbour and add a requirement
-     * all the way between them and the destination
-     */
-    if(FS_ENABLED)
-    {
-      int tempsource = source;
-    
-      while(tempsource!=destination)
-      {
-        int neighbour = nearestNeighbour(tempsource, destination);
-        int l = findLink(tempsource, neighbour);
-        LS[l].setRequirement(LS[l].getRequirement()+1);
-        tempsource = neighbour;
-      }
-    }
+    state.packet_counter++;
+  
+    if(Scheduling::enabled)
+      changePathRequirement(source, destination, 1);
   
-    /* 
-     * Make a new HOP event, incremement the time and reinsert into priority queue
-     */
-    Event hop(now+HOPDELAY,source,destination,HOP);
-    hop.setDelay(HOPDELAY);
-    MR[source].setBuffer(destination);
-    MR[source].setBusy(true);
-    EQ.push(hop);
+    int packet_id = state.packets.allocate(source, destination, now);
+    state.packets[packet_id].id = state.packet_counter;
+    Trace::record(state.run, NEW, now, source, destination, state.packet_counter, 0);
+    enqueue(source, packet_id);
   }
-  //MR buffer full or busy
+  //MR queue full
   else
   {
+    Trace::record(state.run, NEW, now, source, destination, -1, 0);
     /*
     Event drop(now, source, destination, DROP);
-    EQ.push(drop);
+    state.EQ.push(drop);
     */
   }
 }
 
-void Simulation::p_hop(Event E)
+template <class Scheduling, class Trace>
+void Simulation::p_hop(const Event &E)
 {
   int source = E.getSource();
   int destination = E.getDestination();
-  double delay = E.getDelay();
   
   /* Already Arrived */
   if(source == destination)
   {
     Event success(now, source, destination, SUCCESS);
-    success.setDelay(delay);
-    EQ.push(success);
-    if(DEBUGGING)
-      std::cout << "  HOP S: " << source << " D: " << destination << " Time: " << now << std::endl;
+    state.EQ.push(success);
+    Trace::arrived(source, destination, now);
+    
+    const Packet &packet = state.packets[state.queues.front(source)];
+    Trace::record(state.run, HOP, now, source, destination, packet.id, now - packet.created);
   }
   /* Attempt to HOP */
   else
   {
     int neighbour = nearestNeighbour(source, destination);
-    if(DEBUGGING)
-      std::cout << "  HOP S: " << source << " to N: " << neighbour << " with D: " << destination << " Time: " << now << std::endl;
+    Trace::hop(source, neighbour, destination, now);
+    
+    const Packet &sending = state.packets[state.queues.front(source)];
+    Trace::record(state.run, HOP, now, source, neighbour, sending.id, now - sending.created);
       
     /* Free to HOP */
-    if(!MR[neighbour].isBusy() && MR[neighbour].getBuffer() == EMPTY && MR[source].hasPermission() && MR[neighbour].hasPermission())
+    if(!state.queues.full(neighbour) && MR[source].hasPermission() && MR[neighbour].hasPermission())
     {
-      MR[neighbour].setBusy(true);
-      MR[source].setBusy(false);
-      
-      MR[neighbour].setBuffer(destination);
-      MR[source].setBuffer(EMPTY);
+      int packet_id = state.queues.pop(source);
+      state.packets[packet_id].retries = 0;
+      state.packets[packet_id].hops++;
       
       /* Clear the link requirement of source->neighbour once we have hopped */
-      if(FS_ENABLED)
+      if(Scheduling::enabled)
       {
         int l=findLink(source,neighbour);
         LS[l].setRequirement(LS[l].getRequirement()-1);
       }
       
-      Event hop(now+HOPDELAY, neighbour, destination, HOP);
-      hop.setDelay(delay+HOPDELAY);
-      EQ.push(hop);
+      enqueue(neighbour, packet_id);
+      
+      /* move on to the next packet waiting at the source */
+      if(state.queues.empty(source))
+        MR[source].setBusy(false);
+      else
+        startSending(source);
     }
-    /* Neighbour Busy or Full or Either Nodes has no permission */
+    /* Neighbour Full or Either Nodes has no permission */
     else
     {
+      Packet &packet = state.packets[state.queues.front(source)];
+      
+      /* Wait for the next time the source is given permission */
+      if(Scheduling::enabled && params.wait_lists)
+      {
+        state.waiting.park(source, E, now);
+        
+        /* give up at the deadline if it is still parked then (see p_drop) */
+        if(params.max_wait_time > 0)
+        {
+          Event deadline(now + params.max_wait_time, source, EMPTY, DROP);
+          deadline.setDelay(now);
+          state.EQ.push(deadline);
+        }
+      }
       /* Retry if we haven't exceeded the max # of retries */
-      if(!FS_ENABLED || MR[source].getRetries() > MAX_RETRIES)
+      else if(!Scheduling::enabled || packet.retries > params.max_retries)
       {
         Event drop(now, source, destination, DROP);
-        drop.setDelay(delay);
-        EQ.push(drop);
+        state.EQ.push(drop);
       }
       else
       {
         //std::cout << "  RETRY" << std::endl;
-        double d = drand48() * MAX_RETRY_TIME;
+        double d = uniform() * params.max_retry_time;
         Event hop(now+d, source, destination, HOP);
-        hop.setDelay(delay + d);
-        MR[source].setRetries(MR[source].getRetries() + 1);
-        EQ.push(hop);
+        packet.retries++;
+        state.EQ.push(hop);
       }
     }
   }
 }
 
-void Simulation::p_success(Event E)
+template <class Scheduling, class Trace>
+void Simulation::p_success(const Event &E)
 {    
   int source=E.getSource();
-  double delay=E.getDelay();
   
-  if(DEBUGGING)
-    std::cout << "  SUCCESS: " << source << " Time: " << now << std::endl;
+  Trace::success(source, now);
   
-  MR[source].setBusy(false);
-  MR[source].setBuffer(EMPTY);
-  MR[source].setRetries(0);
+  Packet finished = finishSending(source);
+  double delay = now - finished.created;
+  state.delays.success(delay, finished.destination, finished.hops);
+  Trace::record(state.run, SUCCESS, now, source, finished.destination, finished.id, delay);
+  if(params.warmup)
+    state.warmup.add(delay, now);
   
-  success_counter++;
-  high_delay = high_delay + delay;
-  low_delay = low_delay + delay;
+  state.success_counter++;
+  state.high_delay = state.high_delay + delay;
+  state.low_delay = state.low_delay + delay;
 }
 
-void Simulation::p_drop(Event E)
+template <class Scheduling, class Trace>
+void Simulation::p_drop(const Event &E)
 {
   int source = E.getSource();
   int destination = E.getDestination();
-  double delay = E.getDelay();
   
-  if(DEBUGGING)
-    std::cout << "  DROP S: " << source << " D: " << destination << " Time: " << now << std::endl;
-  
-  /* 
-   * try to guess at which links will be used
-   * based on the closest neighbour and remove a requirement
-   * all the way between them and the destination
-   */
-  if(FS_ENABLED)
+  /* a DROP without a destination is the deadline of the packet parked at the time in its delay */
+  if(destination == EMPTY)
   {
-    int tempsource = source;
-  
-    while(tempsource!=destination)
-    {
-      int neighbour = nearestNeighbour(tempsource, destination);
-      int l = findLink(tempsource, neighbour);
-      LS[l].setRequirement(LS[l].getRequirement()-1);
-      tempsource = neighbour;
-    }
+    Event parked;
+    if(!state.waiting.expire(source, E.getDelay(), parked))
+      return;
+    destination = parked.getDestination();
   }
   
-  MR[source].setBusy(false);
-  MR[source].setBuffer(EMPTY);
-  MR[source].setRetries(0);
+  Trace::drop(source, destination, now);
+  
+  if(Scheduling::enabled)
+    changePathRequirement(source, destination, -1);
   
-  high_delay = high_delay + delay;
-  drop_counter++;
+  Packet finished = finishSending(source);
+  double delay = now - finished.created;
+  state.delays.drop(finished.destination, finished.hops);
+  Trace::record(state.run, DROP, now, source, finished.destination, finished.id, delay);
+  
+  state.high_delay = state.high_delay + delay;
+  state.drop_delay = state.drop_delay + delay;
+  state.drop_counter++;
 }
 
 /*
  * Generates a new schedule and all of the
  * start and stop permission events that go with it
  */
-void Simulation::p_schedule(Event E)
+template <class Scheduling, class Trace>
+void Simulation::p_schedule(const Event &E)
 {    
-  Matrix CM(LS);
-  std::vector <Clique> scheduling = CM.generateScheduling();
+  std::vector <Clique> scheduling = generateScheduling();
   
-  if(DEBUGGING)
-  {
-    std::cout << "  GEN SCHEDULE: Time: " << now << std::endl;
-  
-    std::cout << "active links: " << std::endl;
-    for(unsigned int x=0;x<LS.size();x++)
-      if(LS[x].getRequirement() > 0)
-        LS[x].display();
-    std::cout << std::endl;
-  
-    std::cout << "scheduling: " << std::endl;
-    for(unsigned int x=0;x<scheduling.size();x++)
-      scheduling[x].display();
-    std::cout << std::endl;
-  }
+  Trace::schedule(LS, scheduling, now);
+  Trace::record(state.run, SCHEDULE, now, EMPTY, EMPTY, EMPTY, 0);
   
   double start = now;
   double stop = now;
 
   for(unsigned int c=0;c<scheduling.size();c++)
   {
-    Clique schedule = scheduling[c];
+    const Clique &schedule = scheduling[c];
     int weight = schedule.getWeight(LS);
-    stop = stop + (weight * HOPDELAY);
+    stop = stop + (weight * params.hop_delay);
     
     for(unsigned int l=0;l<schedule.size();l++)
     {
       int link_id = schedule.getLink(l);
-      if(DEBUGGING)
-        std::cout << "  L: " << link_id << " T: " << start << " - " << stop << ": " << LS[link_id].getSource() << " & " << LS[link_id].getDestination() << std::endl;
+      Trace::permission(link_id, LS[link_id], start, stop);
       Event pstart(start,LS[link_id].getSource(), LS[link_id].getDestination(), PERMISSION_START);
       Event pstop(stop, LS[link_id].getSource(), LS[link_id].getDestination(), PERMISSION_STOP);
-      EQ.push(pstart);
-      EQ.push(pstop);
+      state.EQ.push(pstart);
+      state.EQ.push(pstop);
     }
     start = stop;
   }
-  Event nschedule(start+HOPDELAY, EMPTY, EMPTY, SCHEDULE);
-  EQ.push(nschedule);
+  Event nschedule(start+params.hop_delay, EMPTY, EMPTY, SCHEDULE);
+  state.EQ.push(nschedule);
 }
 
-void Simulation::p_start(Event E)
+template <class Scheduling, class Trace>
+void Simulation::p_start(const Event &E)
 {
   int source = E.getSource();
   int destination = E.getDestination();
   MR[source].setPermission(true);
   MR[destination].setPermission(true);
   
-  if(DEBUGGING)
-    std::cout << "  GIVE PERMISSION: " << source << " & " << destination << " Time: " << now << std::endl;
+  Trace::permissionStart(source, destination, now);
+  Trace::record(state.run, PERMISSION_START, now, source, destination, EMPTY, 0);
+  
+  if(params.wait_lists)
+  {
+    wakeParked(source);
+    wakeParked(destination);
+  }
+}
+
+/*
+ * Retries every packet parked on the router now that it has permission.
+ * With MAX_WAIT_TIME the packets which are still parked at their deadline
+ * are dropped by p_drop instead.
+ */
+void Simulation::wakeParked(int router_id)
+{
+  Event parked;
+  double parkedAt;
+  
+  while(state.waiting.wake(router_id, parked, parkedAt))
+  {
+    Event retry(now, parked.getSource(), parked.getDestination(), HOP);
+    state.EQ.push(retry);
+  }
+}
+
+/*
+ * Adds a packet to the router's queue, and starts sending it straight
+ * away if the router was idle. With QUEUE_PRIORITY the packets closest
+ * to their destination are sent first.
+ */
+void Simulation::enqueue(int router_id, int packet_id)
+{
+  if(params.queue_priority)
+    state.queues.push(router_id, packet_id, MR[router_id].distance(MR[state.packets[packet_id].destination]));
+  else
+    state.queues.push(router_id, packet_id);
+  
+  if(!MR[router_id].isBusy())
+    startSending(router_id);
+}
+
+/*
+ * Schedules the HOP for the packet at the front of the router's queue
+ */
+void Simulation::startSending(int router_id)
+{
+  int destination = state.packets[state.queues.front(router_id)].destination;
+  Event hop(now+params.hop_delay, router_id, destination, HOP);
+  MR[router_id].setBusy(true);
+  state.EQ.push(hop);
+}
+
+/*
+ * Removes the packet at the front of the router's queue once it has been
+ * delivered or dropped, starts on the next one and returns the finished
+ * packet's record
+ */
+Packet Simulation::finishSending(int router_id)
+{
+  int packet_id = state.queues.pop(router_id);
+  Packet finished = state.packets[packet_id];
+  state.packets.release(packet_id);
+  
+  if(state.queues.empty(router_id))
+    MR[router_id].setBusy(false);
+  else
+    startSending(router_id);
+  return finished;
 }
 
-void Simulation::p_stop(Event E)
+template <class Scheduling, class Trace>
+void Simulation::p_stop(const Event &E)
 {
   int source = E.getSource();
   int destination = E.getDestination();
   MR[source].setPermission(false);
   MR[destination].setPermission(false);
   
-  if(DEBUGGING)
-    std::cout << "  STOP PERMISSION: " << source << " & " << destination << " Time: " << now << std::endl;
+  Trace::permissionStop(source, destination, now);
+  Trace::record(state.run, PERMISSION_STOP, now, source, destination, EMPTY, 0);
 }
 
 void Simulation::pause()
@@ -1,33 +1,13 @@
 #ifndef SIMULATION_H
 #define SIMULATION_H
 
-/* Simulation Parameters */
-#define REPEATS           10     //how many times sim should repeat for more consistent results
+/*
+ * The simulation parameters (repeats, times, FS, queue sizes, dimensions
+ * etc.) are read at runtime, see Parameters.h
+ */
 
-#define FS_ENABLED        1
-#define GW_LOADBALANCING  1       //currently not used
-#define NUM_GWS           1
-
-#define START             0     //time in seconds
-#define END               300
-#define NUMPACKETS        10000
-#define MEAN              0.1 //inter-arrival time
-#define HOPDELAY          0.01
-#define MAX_RETRIES       1
-#define MAX_RETRY_TIME    0.05
-
-#define UPDOWN_RATIO      1.0   //ratio of uplink packets to downlink packets
-
-#define MAX_X             80
-#define MAX_Y             80
-#define MR_RANGE          120
-#define MC_RANGE          60
-
-#define DEBUGGING         0     //toggles debugging information
-#define DISPLAY_PROGRESS  1     //toggles displaying % completed
-
-#include <iostream>       //std::cout/cin, srand48, drand48
-#include <queue>          //std::priority_queue
+#include <iostream>       //std::cout/cin
+#include <cstdlib>        //erand48
 #include <vector>         //std::vector
 #include <limits>         //numeric_limits
 
@@ -41,69 +21,105 @@
 #define PERMISSION_START 5
 #define PERMISSION_STOP 6
 
+#include "Parameters.h"
+#include "Policies.h"
 #include "Event.h"
+#include "RunState.h"
 #include "MeshRouter.h"
+#include "Lattice.h"
 #include "Link.h"
 #include "Matrix.h"
+#include "Coloring.h"
+#include "LocalSearch.h"
+#include "Timeline.h"
+#include "PerfCounters.h"
 
-int main();
+int main(int argc, char *argv[]);
 
 class Simulation
 {
   public:
   /* Constructors */
-  Simulation();
+  Simulation(const Parameters &newParams);
   
   /* Generation functions */
   void generateHexagonalTopology();
   void generateLinks();
   void generateNewPacket();
   
+  void seed(long value);
+  void seedReplication(long base, int replication);
+  void reset();
   void start();
   
   /* Display */
   void displayMRs();
   void displayLinks();
+  void displayNeighbours(int router_id);
   void displayStats();
+  void pause();
   
   /* Stats */
-  double getAvgDelay(){return 
-((double)low_delay/(double)packet_counter+(double)high_delay/(double)packet_counter)/2;};
-  double getPacketDeliveryRatio(){return (double)((double)success_counter / (double)packet_counter) * 100.0;};
+  double getAvgDelay(){return (state.success_counter > 0) ? state.low_delay / (double)state.success_counter : 0;};   /* of the delivered packets */
+  double getAvgDropDelay(){return (state.drop_counter > 0) ? state.drop_delay / (double)state.drop_counter : 0;};
+  double getPacketDeliveryRatio(){return (double)((double)state.success_counter / (double)state.packet_counter) * 100.0;};
+  bool hasSteadyStateDelay(){return state.warmup.hasTruncation();};
+  double getSteadyStateDelay(){return state.warmup.getMean();};
   int getNumMRs(){return (int)MR.size();};
   int getNumGWs(){return (int)GW.size();};
+  long getEvents(){return state.events;};
+  unsigned int getPeakQueue(){return state.peak_queue;};
+  double getScheduleSeconds(){return state.schedule_seconds;};
   
   private:
+  /*
+   * The main loop and the event functions are templates over a
+   * scheduling policy and an instrumentation policy (see Policies.h).
+   * selectRun() returns the instantiation for the run's parameters.
+   */
+  typedef void (Simulation::*RunFunction)();
+  RunFunction selectRun();
+  template <class Scheduling, class Trace> void run();
+  
   /* Event Functions */
-  void p_new(Event E);
-  void p_hop(Event E);
-  void p_success(Event E);
-  void p_drop(Event E);
-  void p_schedule(Event E);
-  void p_start(Event E);
-  void p_stop(Event E);
+  template <class Scheduling, class Trace> void p_new(const Event &E);
+  template <class Scheduling, class Trace> void p_hop(const Event &E);
+  template <class Scheduling, class Trace> void p_success(const Event &E);
+  template <class Scheduling, class Trace> void p_drop(const Event &E);
+  template <class Scheduling, class Trace> void p_schedule(const Event &E);
+  template <class Scheduling, class Trace> void p_start(const Event &E);
+  template <class Scheduling, class Trace> void p_stop(const Event &E);
   
   /* Helper Functions */
   int nearestMeshRouter(double x, double y);
   int nearestNeighbour(unsigned int router_id, int destination);
   int nearestGW(int router_id);
   int findLink(int source, int destination);
-  void pause();
+  void wakeParked(int router_id);
+  void enqueue(int router_id, int packet_id);
+  void startSending(int router_id);
+  Packet finishSending(int router_id);
+  void changePathRequirement(int source, int destination, int change);
+  std::vector <Clique> generateScheduling();
+  std::vector <Clique> generateBudgetedScheduling();
   
   /* Generation Functions */
-  void generateNeighbours();
   void generateGWs();
   
-  std::priority_queue<Event> EQ;
-  std::vector<MeshRouter> MR;
+  /* Random Numbers */
+  double uniform(){return erand48(randomState);};
+  
+  Parameters params;
+  RouterTable MR;
+  Lattice lattice;
   std::vector<Link> LS;
   std::vector<int> GW;
   
-  /* statistic variables */
+  /* events, queues and statistics of the current run */
+  RunState state;
+  PerfCounters counters;  //the topology phase is kept, the others are reset every run
+  unsigned short randomState[3];  //erand48 state, see seed()
   double now;
-  int packet_counter, success_counter, drop_counter, progress;
-  double high_delay;      //over-estimate using dropped delays
-  double low_delay;       //under-estimate using only success delays
 };
 
 #endif
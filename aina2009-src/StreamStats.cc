@@ -0,0 +1,352 @@
+#ifndef STREAMSTATS_CC
+#define STREAMSTATS_CC
+
+#include "StreamStats.h"
+#include <iostream>       //std::cout
+#include <cmath>          //sqrt, fabs
+#include <algorithm>      //std::sort, std::max
+
+/*
+ * Two-sided 95% critical values of Student's t for 1 to 30 degrees of
+ * freedom, beyond which the Cornish-Fisher expansion around the normal
+ * value is used
+ */
+static const double tTable[30] = {12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+  2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+  2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042};
+
+static double studentT95(long df)
+{
+  if(df <= 30)
+    return tTable[df-1];
+  double z = 1.959964;
+  return z + (z*z*z + z) / (4.0 * df) + (5*pow(z, 5) + 16*z*z*z + 3*z) / (96.0 * df * df);
+}
+
+/* ---- RunningStat ---- */
+
+RunningStat::RunningStat()
+{
+  reset();
+}
+
+void RunningStat::reset()
+{
+  n = 0;
+  mean = 0;
+  m2 = 0;
+  min = 0;
+  max = 0;
+}
+
+void RunningStat::add(double x)
+{
+  n++;
+  double d = x - mean;
+  mean = mean + d / (double)n;
+  m2 = m2 + d * (x - mean);
+  if(n == 1 || x < min)
+    min = x;
+  if(n == 1 || x > max)
+    max = x;
+}
+
+double RunningStat::getStdDev() const
+{
+  return sqrt(getVariance());
+}
+
+/*
+ * Returns the half-width of the 95% confidence interval of the mean,
+ * 0 until there are two values
+ */
+double RunningStat::getHalfWidth() const
+{
+  if(n < 2)
+    return 0;
+  return studentT95(n-1) * getStdDev() / sqrt((double)n);
+}
+
+/* ---- P2Quantile ---- */
+
+P2Quantile::P2Quantile(double newP)
+{
+  p = newP;
+  reset();
+}
+
+void P2Quantile::reset()
+{
+  n = 0;
+  for(int i=0;i<5;i++)
+  {
+    heights[i] = 0;
+    positions[i] = i + 1;
+  }
+  desired[0] = 1;
+  desired[1] = 1 + 2*p;
+  desired[2] = 1 + 4*p;
+  desired[3] = 3 + 2*p;
+  desired[4] = 5;
+  increments[0] = 0;
+  increments[1] = p/2;
+  increments[2] = p;
+  increments[3] = (1+p)/2;
+  increments[4] = 1;
+}
+
+void P2Quantile::add(double x)
+{
+  /* the first five values are the markers, in order */
+  if(n < 5)
+  {
+    heights[n] = x;
+    n++;
+    if(n == 5)
+      std::sort(heights, heights+5);
+    return;
+  }
+  n++;
+  
+  /* find the cell x falls in, stretching the ends to include it */
+  int k;
+  if(x < heights[0])
+  {
+    heights[0] = x;
+    k = 0;
+  }
+  else if(x >= heights[4])
+  {
+    heights[4] = x;
+    k = 3;
+  }
+  else
+  {
+    k = 0;
+    while(x >= heights[k+1])
+      k++;
+  }
+  
+  for(int i=k+1;i<5;i++)
+    positions[i] = positions[i] + 1;
+  for(int i=0;i<5;i++)
+    desired[i] = desired[i] + increments[i];
+  
+  /* move the middle markers which are off their desired positions by one or more */
+  for(int i=1;i<4;i++)
+  {
+    double off = desired[i] - positions[i];
+    if((off >= 1 && positions[i+1] - positions[i] > 1) || (off <= -1 && positions[i-1] - positions[i] < -1))
+    {
+      int d = (off > 0) ? 1 : -1;
+      double height = parabolic(i, d);
+      if(heights[i-1] < height && height < heights[i+1])
+        heights[i] = height;
+      else
+        heights[i] = linear(i, d);
+      positions[i] = positions[i] + d;
+    }
+  }
+}
+
+double P2Quantile::parabolic(int i, int d) const
+{
+  return heights[i] + d / (positions[i+1] - positions[i-1]) *
+    ((positions[i] - positions[i-1] + d) * (heights[i+1] - heights[i]) / (positions[i+1] - positions[i]) +
+     (positions[i+1] - positions[i] - d) * (heights[i] - heights[i-1]) / (positions[i] - positions[i-1]));
+}
+
+double P2Quantile::linear(int i, int d) const
+{
+  return heights[i] + d * (heights[i+d] - heights[i]) / (positions[i+d] - positions[i]);
+}
+
+/*
+ * Returns the estimate, exact while there are five values or fewer
+ */
+double P2Quantile::getValue() const
+{
+  if(n >= 5)
+    return heights[2];
+  if(n == 0)
+    return 0;
+  
+  double sorted[5];
+  std::copy(heights, heights+n, sorted);
+  std::sort(sorted, sorted+n);
+  return sorted[(int)(p * (n-1) + 0.5)];
+}
+
+/* ---- DelayStats ---- */
+
+DelayStats::DelayStats() : median(0.5), p90(0.9), p99(0.99)
+{
+}
+
+/*
+ * Clears the statistics, for a run over numRouters MRs (any of which
+ * might be a GW)
+ */
+void DelayStats::reset(int numRouters)
+{
+  delivered.reset();
+  median.reset();
+  p90.reset();
+  p99.reset();
+  gatewayDelay.assign(numRouters, RunningStat());
+  gatewayDrops.assign(numRouters, 0);
+  hopDelay.clear();
+  hopDrops.clear();
+}
+
+/*
+ * Makes room for the hop count in the breakdown by hops
+ */
+void DelayStats::grow(int hops)
+{
+  if(hops >= (int)hopDelay.size())
+  {
+    hopDelay.resize(hops+1);
+    hopDrops.resize(hops+1, 0);
+  }
+}
+
+void DelayStats::success(double delay, int gateway, int hops)
+{
+  grow(hops);
+  delivered.add(delay);
+  median.add(delay);
+  p90.add(delay);
+  p99.add(delay);
+  gatewayDelay[gateway].add(delay);
+  hopDelay[hops].add(delay);
+}
+
+void DelayStats::drop(int gateway, int hops)
+{
+  grow(hops);
+  gatewayDrops[gateway]++;
+  hopDrops[hops]++;
+}
+
+void DelayStats::display() const
+{
+  std::cout << "Delivered Delay: Mean: " << delivered.getMean() << "\tSD: " << delivered.getStdDev() << "\tMax: " << delivered.getMax()
+            << "\tP50: " << median.getValue() << "\tP90: " << p90.getValue() << "\tP99: " << p99.getValue() << std::endl;
+  for(unsigned int g=0;g<gatewayDelay.size();g++)
+    if(gatewayDelay[g].getCount() > 0 || gatewayDrops[g] > 0)
+      std::cout << "  GW " << g << ":\tDelivered: " << gatewayDelay[g].getCount() << "\tDropped: " << gatewayDrops[g] << "\tMean Delay: " << gatewayDelay[g].getMean() << std::endl;
+  for(unsigned int h=0;h<hopDelay.size();h++)
+    if(hopDelay[h].getCount() > 0 || hopDrops[h] > 0)
+      std::cout << "  " << h << " Hops:\tDelivered: " << hopDelay[h].getCount() << "\tDropped: " << hopDrops[h] << "\tMean Delay: " << hopDelay[h].getMean() << std::endl;
+}
+
+/* ---- WarmupDetector ---- */
+
+WarmupDetector::WarmupDetector()
+{
+  reset(0);
+}
+
+/*
+ * Clears the values, for a run which is steady once the half-width of
+ * the truncated mean is within newPrecision of it (0 never is)
+ */
+void WarmupDetector::reset(double newPrecision)
+{
+  batches.clear();
+  batchTimes.clear();
+  sum = 0;
+  filled = 0;
+  nextUpdate = 2 * MSER_GROUPS;
+  truncation = 0;
+  mean = 0;
+  halfWidth = 0;
+  precision = newPrecision;
+  found = false;
+  steady = false;
+}
+
+/*
+ * Adds a value seen at the given time. The truncation point is updated
+ * every tenth growth in the batches (at least every MSER_GROUPS), so the
+ * searches cost O(n) overall.
+ */
+void WarmupDetector::add(double x, double time)
+{
+  sum = sum + x;
+  filled++;
+  if(filled < MSER_BATCH)
+    return;
+  
+  batches.push_back(sum / MSER_BATCH);
+  batchTimes.push_back(time);
+  sum = 0;
+  filled = 0;
+  if(batches.size() >= nextUpdate)
+  {
+    update();
+    nextUpdate = batches.size() + std::max((unsigned int)MSER_GROUPS, (unsigned int)batches.size() / 10);
+  }
+}
+
+/*
+ * Finds the truncation point, the truncated mean and its half-width,
+ * from all the batches so far. Needs 2 * MSER_GROUPS batches.
+ */
+void WarmupDetector::update()
+{
+  unsigned int n = batches.size();
+  if(n < 2 * MSER_GROUPS)
+    return;
+  found = true;
+  
+  /* the sums over batches d..n-1, from the end */
+  double s1 = 0, s2 = 0, best = -1;
+  for(int d=n-1;d>=0;d--)
+  {
+    s1 = s1 + batches[d];
+    s2 = s2 + batches[d] * batches[d];
+    if(d > (int)n / 2)
+      continue;
+    double kept = n - d;
+    double mser = (s2 - s1 * s1 / kept) / (kept * kept);
+    if(best < 0 || mser <= best)
+    {
+      best = mser;
+      truncation = d;
+      mean = s1 / kept;
+    }
+  }
+  
+  /* batch means of the kept batches, dropping the oldest left over */
+  unsigned int groupSize = (n - truncation) / MSER_GROUPS;
+  RunningStat groups;
+  for(unsigned int first=n - groupSize * MSER_GROUPS;first<n;first+=groupSize)
+  {
+    double groupSum = 0;
+    for(unsigned int b=first;b<first+groupSize;b++)
+      groupSum = groupSum + batches[b];
+    groups.add(groupSum / groupSize);
+  }
+  halfWidth = groups.getHalfWidth();
+  
+  /*
+   * A truncation at the end of the search means the run is still warming
+   * up, and a mean of 0 (nothing delayed) has no relative precision
+   */
+  steady = precision > 0 && mean != 0 && truncation < n / 2 && halfWidth <= precision * fabs(mean);
+}
+
+void WarmupDetector::display() const
+{
+  if(!found)
+  {
+    std::cout << "Warm-up (MSER-5): insufficient data, needs " << 2 * MSER_GROUPS * MSER_BATCH << " delivered packets" << std::endl;
+    return;
+  }
+  std::cout << "Warm-up (MSER-5): " << getTruncated() << " delivered packets, until " << (truncation > 0 ? batchTimes[truncation-1] : 0)
+<< "s\tSteady-State Delay: " << mean << " +/- " << halfWidth << (steady ? "\t(steady)" : "") << std::endl;
+}
+
+#endif
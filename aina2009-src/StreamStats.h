@@ -0,0 +1,123 @@
+#ifndef STREAMSTATS_H
+#define STREAMSTATS_H
+
+#include <vector>         //std::vector
+
+/*
+ * Mean, variance, min and max of a stream of values in constant memory
+ * (Welford's method), and the 95% confidence half-width of the mean from
+ * Student's t, e.g. over the results of the replications
+ */
+class RunningStat
+{
+  public:
+  RunningStat();
+  
+  void reset();
+  void add(double x);
+  
+  long getCount() const {return n;};
+  double getMean() const {return mean;};
+  double getVariance() const {return (n > 1) ? m2 / (double)(n-1) : 0;};
+  double getStdDev() const;
+  double getMin() const {return min;};
+  double getMax() const {return max;};
+  double getHalfWidth() const;
+  
+  private:
+  long n;
+  double mean, m2, min, max;
+};
+
+/*
+ * Estimate of the p-quantile of a stream in constant memory with the P²
+ * algorithm (Jain and Chlamtac), which moves five markers towards the
+ * min, p/2, p, (1+p)/2 and max quantiles as values arrive
+ */
+class P2Quantile
+{
+  public:
+  P2Quantile(double newP);
+  
+  void reset();
+  void add(double x);
+  double getValue() const;
+  
+  private:
+  double parabolic(int i, int d) const;
+  double linear(int i, int d) const;
+  
+  double p;
+  long n;
+  double heights[5];
+  double positions[5], desired[5], increments[5];
+};
+
+/*
+ * Streaming statistics of the packets finished in a run: the delay of
+ * the delivered packets with its median, 90th and 99th percentiles, and
+ * the delivered and dropped packets broken down by their GW and by the
+ * number of hops they travelled. Cheap enough to update on every
+ * SUCCESS and DROP.
+ */
+class DelayStats
+{
+  public:
+  DelayStats();
+  
+  void reset(int numRouters);
+  void success(double delay, int gateway, int hops);
+  void drop(int gateway, int hops);
+  void display() const;
+  
+  const RunningStat &getDelay() const {return delivered;};
+  
+  private:
+  void grow(int hops);
+  
+  RunningStat delivered;
+  P2Quantile median, p90, p99;
+  std::vector<RunningStat> gatewayDelay, hopDelay;   //delays of the delivered packets
+  std::vector<long> gatewayDrops, hopDrops;
+};
+
+/*
+ * Online warm-up detection with MSER-5 (White): the values are averaged
+ * in batches of five, and the warm-up is the number of leading batches
+ * whose removal minimises the standard error of the mean of the rest,
+ * searched over the first half. The truncated mean's 95% half-width comes
+ * from MSER_GROUPS batch means of what is left. With a precision the run
+ * is steady once that half-width is within precision of the mean.
+ */
+#define MSER_BATCH 5
+#define MSER_GROUPS 20
+
+class WarmupDetector
+{
+  public:
+  WarmupDetector();
+  
+  void reset(double newPrecision);
+  void add(double x, double time);
+  void update();
+  void display() const;
+  
+  bool hasTruncation() const {return found;};
+  bool isSteady() const {return steady;};
+  long getTruncated() const {return (long)truncation * MSER_BATCH;};
+  double getMean() const {return mean;};
+  double getHalfWidth() const {return halfWidth;};
+  
+  private:
+  std::vector<double> batches;      //batch means
+  std::vector<double> batchTimes;   //when each batch was completed
+  double sum;                       //of the batch being filled
+  int filled;
+  unsigned int nextUpdate;          //batches at which update() is next called by add()
+  unsigned int truncation;          //batches discarded as the warm-up
+  double mean, halfWidth, precision;
+  bool found;                       //update() has had enough batches, so the truncation, mean and half-width are set
+  bool steady;
+};
+
+#endif
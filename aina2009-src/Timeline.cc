@@ -0,0 +1,112 @@
+#ifndef TIMELINE_CC
+#define TIMELINE_CC
+
+#include "Timeline.h"
+#include <iostream>       //std::cout
+#include <fstream>        //std::ofstream
+#include <chrono>         //std::chrono::steady_clock
+#include <cstdlib>        //atexit
+
+std::atomic<bool> Timeline::active(false);
+
+/* A recorded span and the ring buffer of one thread */
+struct TimelineSpan
+{
+  const char *name;
+  long arg;
+  long long begin, end;
+};
+
+struct TimelineBuffer
+{
+  TimelineSpan spans[TIMELINE_CAPACITY];
+  std::atomic<unsigned long> count;   //spans ever recorded, only the owner writes it
+  int thread;
+  TimelineBuffer *next;
+};
+
+static std::string tracePath;
+static std::atomic<TimelineBuffer *> buffers(NULL);
+static std::atomic<int> threads(0);
+static thread_local TimelineBuffer *localBuffer = NULL;
+static const std::chrono::steady_clock::time_point processStarted = std::chrono::steady_clock::now();
+
+/*
+ * Starts recording, to be written to path when the program exits
+ */
+void Timeline::open(const std::string &path)
+{
+  if(!active.exchange(true))
+    atexit(dump);
+  tracePath = path;
+}
+
+/*
+ * Returns the time in ns since the program started
+ */
+long long Timeline::now()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - processStarted).count();
+}
+
+/*
+ * Adds a span to the calling thread's buffer, creating and linking the
+ * buffer in on the thread's first span
+ */
+void Timeline::record(const char *name, long arg, long long begin, long long end)
+{
+  if(localBuffer == NULL)
+  {
+    localBuffer = new TimelineBuffer;
+    localBuffer->count.store(0);
+    localBuffer->thread = threads++;
+    localBuffer->next = buffers.load();
+    while(!buffers.compare_exchange_weak(localBuffer->next, localBuffer))
+      ;
+  }
+  
+  unsigned long count = localBuffer->count.load(std::memory_order_relaxed);
+  TimelineSpan &span = localBuffer->spans[count % TIMELINE_CAPACITY];
+  span.name = name;
+  span.arg = arg;
+  span.begin = begin;
+  span.end = end;
+  localBuffer->count.store(count + 1, std::memory_order_release);
+}
+
+/*
+ * Writes every buffered span as a complete ("X") event of the Chrome
+ * trace format, with times in us
+ */
+void Timeline::dump()
+{
+  std::ofstream out(tracePath.c_str());
+  if(!out)
+  {
+    std::cout << "Error, could not write the trace file " << tracePath << std::endl;
+    return;
+  }
+  
+  out << std::fixed;
+  out.precision(3);
+  out << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+  bool first = true;
+  for(TimelineBuffer *buffer = buffers.load(); buffer != NULL; buffer = buffer->next)
+  {
+    unsigned long count = buffer->count.load(std::memory_order_acquire);
+    unsigned long oldest = (count > TIMELINE_CAPACITY) ? count - TIMELINE_CAPACITY : 0;
+    for(unsigned long s=oldest;s<count;s++)
+    {
+      const TimelineSpan &span = buffer->spans[s % TIMELINE_CAPACITY];
+      out << (first ? "\n" : ",\n") << "{\"name\": \"" << span.name << "\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << buffer->thread
+          << ", \"ts\": " << span.begin / 1000.0 << ", \"dur\": " << (span.end - span.begin) / 1000.0;
+      if(span.arg >= 0)
+        out << ", \"args\": {\"n\": " << span.arg << "}";
+      out << "}";
+      first = false;
+    }
+  }
+  out << "\n]}" << std::endl;
+}
+
+#endif
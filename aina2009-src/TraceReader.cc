@@ -0,0 +1,83 @@
+#ifndef TRACEREADER_CC
+#define TRACEREADER_CC
+
+#include "TraceReader.h"
+#include <iostream>       //std::cout
+#include <cstring>        //memcmp
+#include <fcntl.h>        //open
+#include <unistd.h>       //close
+#include <sys/mman.h>     //mmap, munmap
+#include <sys/stat.h>     //fstat
+
+TraceReader::TraceReader()
+{
+  mapping = NULL;
+  length = 0;
+  records = NULL;
+  count = 0;
+}
+
+TraceReader::~TraceReader()
+{
+  close();
+}
+
+/*
+ * Maps the trace at path, returns false (saying why) if it cannot be read
+ * or was not written by this version of EventTrace. A trace cut short
+ * ends at its last whole record.
+ */
+bool TraceReader::open(const std::string &path)
+{
+  close();
+  
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if(fd < 0)
+  {
+    std::cout << "Error, could not read the event trace " << path << std::endl;
+    return false;
+  }
+  struct stat info;
+  if(fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(TraceHeader))
+  {
+    std::cout << "Error, " << path << " is not an event trace" << std::endl;
+    ::close(fd);
+    return false;
+  }
+  
+  length = (size_t)info.st_size;
+  mapping = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if(mapping == MAP_FAILED)
+  {
+    std::cout << "Error, could not map the event trace " << path << std::endl;
+    mapping = NULL;
+    length = 0;
+    return false;
+  }
+  madvise(mapping, length, MADV_SEQUENTIAL);
+  
+  const TraceHeader *header = (const TraceHeader *)mapping;
+  if(memcmp(header->magic, EVENT_TRACE_MAGIC, sizeof(header->magic)) != 0 || header->version != EVENT_TRACE_VERSION || header->recordSize != sizeof(TraceRecord))
+  {
+    std::cout << "Error, " << path << " is not a version " << EVENT_TRACE_VERSION << " event trace" << std::endl;
+    close();
+    return false;
+  }
+  
+  records = (const TraceRecord *)((const char *)mapping + sizeof(TraceHeader));
+  count = (length - sizeof(TraceHeader)) / sizeof(TraceRecord);
+  return true;
+}
+
+void TraceReader::close()
+{
+  if(mapping != NULL)
+    munmap(mapping, length);
+  mapping = NULL;
+  length = 0;
+  records = NULL;
+  count = 0;
+}
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef TRACEREADER_H
+#define TRACEREADER_H
+
+#include <string>         //std::string
+#include <cstddef>        //size_t
+
+#include "EventTrace.h"
+
+/*
+ * Reads a binary EventTrace in place: the file is mapped read-only and
+ * the records are handed out as pointers into the mapping, so nothing is
+ * copied or parsed and a trace larger than memory is paged in as it is
+ * walked.
+ *
+ *   TraceReader trace;
+ *   if(trace.open("run.trace"))
+ *     for(const TraceRecord *r = trace.begin(); r != trace.end(); r++)
+ *       ...
+ */
+class TraceReader
+{
+  public:
+  TraceReader();
+  ~TraceReader();
+  
+  bool open(const std::string &path);
+  void close();
+  
+  /* Accessors */
+  size_t size() const {return count;};
+  const TraceRecord &operator[](size_t record) const {return records[record];};
+  const TraceRecord *begin() const {return records;};
+  const TraceRecord *end() const {return records + count;};
+  
+  private:
+  TraceReader(const TraceReader &);
+  TraceReader &operator=(const TraceReader &);
+  
+  void *mapping;
+  size_t length;
+  const TraceRecord *records;
+  size_t count;
+};
+
+#endif
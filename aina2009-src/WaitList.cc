@@ -0,0 +1,100 @@
+#ifndef WAITLIST_CC
+#define WAITLIST_CC
+
+#include "WaitList.h"
+
+/*
+ * Empties all of the lists and makes room for num_routers of them
+ */
+void WaitList::resize(int num_routers)
+{
+  nodes.clear();
+  head.assign(num_routers, -1);
+  tail.assign(num_routers, -1);
+  freeNodes = -1;
+  parked = 0;
+}
+
+/*
+ * Parks the event at the end of the router's list
+ */
+void WaitList::park(int router_id, const Event &E, double time)
+{
+  int n;
+  if(freeNodes != -1)
+  {
+    n = freeNodes;
+    freeNodes = nodes[n].next;
+  }
+  else
+  {
+    n = (int)nodes.size();
+    nodes.push_back(Node());
+  }
+  
+  nodes[n].event = E;
+  nodes[n].time = time;
+  nodes[n].next = -1;
+  
+  if(tail[router_id] == -1)
+    head[router_id] = n;
+  else
+    nodes[tail[router_id]].next = n;
+  tail[router_id] = n;
+  parked++;
+}
+
+/*
+ * Removes the first event parked on the router, returning it and the
+ * time it was parked. Returns false if nothing is waiting there.
+ */
+bool WaitList::wake(int router_id, Event &E, double &time)
+{
+  int n = head[router_id];
+  if(n == -1)
+    return false;
+  
+  E = nodes[n].event;
+  time = nodes[n].time;
+  
+  head[router_id] = nodes[n].next;
+  if(head[router_id] == -1)
+    tail[router_id] = -1;
+  
+  nodes[n].next = freeNodes;
+  freeNodes = n;
+  parked--;
+  return true;
+}
+
+/*
+ * Removes the event parked on the router at the given time, returning
+ * it. Returns false if it has already been woken.
+ */
+bool WaitList::expire(int router_id, double time, Event &E)
+{
+  int previous = -1;
+  int n = head[router_id];
+  while(n != -1 && nodes[n].time != time)
+  {
+    previous = n;
+    n = nodes[n].next;
+  }
+  if(n == -1)
+    return false;
+  
+  E = nodes[n].event;
+  if(previous == -1)
+    head[router_id] = nodes[n].next;
+  else
+    nodes[previous].next = nodes[n].next;
+  if(tail[router_id] == n)
+    tail[router_id] = previous;
+  
+  nodes[n].next = freeNodes;
+  freeNodes = n;
+  parked--;
+  return true;
+}
+
+#endif
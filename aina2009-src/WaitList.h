@@ -0,0 +1,43 @@
+#ifndef WAITLIST_H
+#define WAITLIST_H
+
+#include <vector>         //std::vector
+
+#include "Event.h"
+
+/*
+ * Per-router FIFO lists of blocked HOP events. Instead of polling with
+ * retry events, a blocked packet is parked on a router until that router
+ * is given permission again, and then it is woken up to try once more.
+ * The lists are linked through one shared pool of nodes, which are
+ * recycled, so parking a packet does not allocate. With MAX_WAIT_TIME a
+ * packet can also be taken out of the middle of a list by expire().
+ */
+class WaitList
+{
+  public:
+  /* Mutators */
+  void resize(int num_routers);
+  void park(int router_id, const Event &E, double time);
+  bool wake(int router_id, Event &E, double &time);
+  bool expire(int router_id, double time, Event &E);
+  
+  /* Accessors */
+  bool empty(int router_id) const {return head[router_id] == -1;};
+  int size() const {return parked;};
+  
+  private:
+  struct Node
+  {
+    Event event;
+    double time;            //when the packet was parked
+    int next;
+  };
+  
+  std::vector<Node> nodes;
+  std::vector<int> head, tail;
+  int freeNodes;
+  int parked;
+};
+
+#endif
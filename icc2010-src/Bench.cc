@@ -0,0 +1,177 @@
+/*
+ * Microbenchmarks for the simulator kernels: topology generation (placement,
+ * GWs, MCs and routes), walking the routes, event queue push/pop, clique
+ * decomposition, the colouring schedulers and the local search. Sizes run from
+ * 10 to 10,000 routers or events, 10 to 5,000 active links and 4 to 16 links
+ * per decomposed clique; the scheduler times are per link. Results go to the
+ * screen and, as CSV, to the given file (see BenchHarness.h).
+ *
+ * The schedulers here only see conflicts between links sharing an MR, since
+ * the range test lives in Simulation::interfere.
+ *
+ * usage: ./wmn-bench [csv file] [repetitions] [seconds per kernel and size]
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+#include <memory>
+#include <algorithm>
+
+#include "BenchHarness.h"
+#include "Topology.h"
+#include "Event.h"
+#include "EventQueue.h"
+#include "Clique.h"
+#include "Coloring.h"
+#include "LocalSearch.h"
+
+#define RANGE 60
+#define SEARCH_ITERATIONS 10000
+
+/*
+ * Returns a topology of num_mr MRs, one GW per 50 MRs and two MCs per MR
+ */
+static Topology *newTopology(int num_mr)
+{
+	int side = (int)(sqrt(num_mr) * 2 * RANGE / 3);
+	return new Topology(side, side, num_mr, num_mr / 50 + 1, 2 * num_mr, RANGE);
+}
+
+/*
+ * Returns the links of each schedule round laid end to end
+ */
+static std::vector<Link> flatten(const std::vector<Clique> &schedule)
+{
+	std::vector<Link> links;
+	for(int c=0;c<(int)schedule.size();c++)
+		links.insert(links.end(), schedule[c].links.begin(), schedule[c].links.end());
+	return links;
+}
+
+/*
+ * Returns for each link the indices of the links which share an MR with it
+ */
+static std::vector< std::vector<int> > sharedConflicts(const std::vector<Link> &links)
+{
+	std::vector< std::vector<int> > at_router;
+	for(int x=0;x<(int)links.size();x++)
+	{
+		int ends[2] = {links[x].first, links[x].second};
+		for(int e=0;e<2;e++)
+		{
+			if(ends[e] >= (int)at_router.size())
+				at_router.resize(ends[e] + 1);
+			at_router[ends[e]].push_back(x);
+		}
+	}
+	
+	std::vector< std::vector<int> > conflicts(links.size());
+	for(int r=0;r<(int)at_router.size();r++)
+		for(int a=0;a<(int)at_router[r].size();a++)
+			for(int b=0;b<(int)at_router[r].size();b++)
+				if(a != b)
+					conflicts[at_router[r][a]].push_back(at_router[r][b]);
+	return conflicts;
+}
+
+int main(int argc, char *argv[])
+{
+	const char *csv_path = argc > 1 ? argv[1] : "bench.csv";
+	int reps = argc > 2 ? atoi(argv[2]) : 10;
+	double max_seconds = argc > 3 ? atof(argv[3]) : 2.0;
+	BenchHarness bench(csv_path, reps, max_seconds);
+	srand48(7);
+	
+	const int router_sizes[] = {10, 100, 1000, 10000};
+	const int link_sizes[] = {10, 100, 1000, 5000};
+	const int clique_sizes[] = {4, 8, 12, 16};
+	
+	for(int s=0;s<(int)(sizeof(router_sizes)/sizeof(router_sizes[0]));s++)
+	{
+		int size = router_sizes[s];
+		std::unique_ptr<Topology> topology;
+		
+		bench.run("topology", size, size, []{}, [&]{
+			topology.reset(newTopology(size));
+			return (long)topology->getLS().size();
+		});
+		
+		long hops = 0;
+		for(int r=0;r<size;r++)
+			for(int next=topology->getNextHop(r); next != -1; next=topology->getNextHop(next))
+				hops++;
+		bench.run("route-walk", size, hops > 0 ? hops : 1, []{}, [&]{
+			long walked = 0;
+			for(int r=0;r<size;r++)
+				for(int next=topology->getNextHop(r); next != -1; next=topology->getNextHop(next))
+					walked += next;
+			return walked;
+		});
+		
+		std::vector<double> times(size);
+		for(int e=0;e<size;e++)
+			times[e] = drand48() * 300;
+		for(int ticks=0;ticks<2;ticks++)
+		{
+			EventQueue EQ;
+			EQ.setResolution(ticks ? 1e9 : 0);
+			bench.run(ticks ? "event-queue-ticks" : "event-queue", size, 2 * size, [&]{ EQ.clear(); }, [&]{
+				for(int e=0;e<size;e++)
+					EQ.push(Event(0, e, e, times[e], times[e]));
+				long order = 0;
+				while(!EQ.empty())
+				{
+					order += EQ.top().getSource();
+					EQ.pop();
+				}
+				return order;
+			});
+		}
+	}
+	
+	for(int s=0;s<(int)(sizeof(clique_sizes)/sizeof(clique_sizes[0]));s++)
+	{
+		int size = clique_sizes[s];
+		Clique clique;
+		for(int l=0;l<size;l++)
+			clique.links.push_back(Link(2 * l, 2 * l + 1));
+		bench.run("clique-decompose", size, 1L << size, []{}, [&]{
+			return (long)clique.decompose().size();
+		});
+	}
+	
+	for(int s=0;s<(int)(sizeof(link_sizes)/sizeof(link_sizes[0]));s++)
+	{
+		int size = link_sizes[s];
+		std::unique_ptr<Topology> topology(newTopology(size + size / 50 + 1));
+		const std::vector<Link> &LS = topology->getLS();
+		std::vector<Link> active(LS.begin(), LS.begin() + std::min((int)LS.size(), size));
+		for(int l=0;l<(int)active.size();l++)
+			active[l].requirement = 1 + (int)(drand48() * 4);
+		std::vector< std::vector<int> > conflicts = sharedConflicts(active);
+		
+		bench.run("dsatur", size, active.size(), []{}, [&]{
+			Coloring engine(active, conflicts, true, false);
+			return (long)engine.generate().size();
+		});
+		
+		bench.run("lrf", size, active.size(), []{}, [&]{
+			Coloring engine(active, conflicts, false, false);
+			return (long)engine.generate().size();
+		});
+		
+		Coloring seed(active, conflicts, true, false);
+		std::vector<Clique> initial = seed.generate();
+		std::vector< std::vector<int> > scheduled = sharedConflicts(flatten(initial));
+		std::vector<Clique> schedule;
+		bench.run("local-search", size, active.size(), [&]{ schedule = initial; }, [&]{
+			LocalSearch pass;
+			return (long)pass.improve(schedule, scheduled, SEARCH_ITERATIONS);
+		});
+	}
+	
+	std::cout << "checksum: " << bench.getChecksum() << std::endl;
+	return 0;
+}
@@ -0,0 +1,62 @@
+#ifndef BENCHHARNESS_CC
+#define BENCHHARNESS_CC
+
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+
+#include "BenchHarness.h"
+
+/*
+ * Constructor which opens the CSV file and writes its header
+ */
+BenchHarness::BenchHarness(const char *csv_path, int _reps, double _max_seconds)
+{
+	reps = _reps;
+	max_seconds = _max_seconds;
+	checksum = 0;
+	
+	csv.open(csv_path);
+	if(!csv)
+	{
+		std::cout << "Error, could not open " << csv_path << " for writing" << std::endl;
+		exit(255);
+	}
+	csv << "kernel,size,reps,ops,mean_ns_per_op,stddev_ns_per_op,min_ns_per_op" << std::endl;
+}
+
+/*
+ * Returns the sum of the kernel checksums
+ */
+long BenchHarness::getChecksum() const
+{
+	return checksum;
+}
+
+/*
+ * Writes the mean, sample standard deviation and minimum of the samples
+ * to the CSV file and the screen
+ */
+void BenchHarness::record(const char *kernel_name, int size, long ops, const std::vector<double> &samples)
+{
+	double mean = 0;
+	double min = samples[0];
+	for(int s=0;s<(int)samples.size();s++)
+	{
+		mean += samples[s];
+		if(samples[s] < min)
+			min = samples[s];
+	}
+	mean /= samples.size();
+	
+	double variance = 0;
+	for(int s=0;s<(int)samples.size();s++)
+		variance += (samples[s] - mean) * (samples[s] - mean);
+	if(samples.size() > 1)
+		variance /= samples.size() - 1;
+	
+	csv << kernel_name << "," << size << "," << samples.size() << "," << ops << "," << mean << "," << sqrt(variance) << "," << min << std::endl;
+	std::cout << kernel_name << "\tsize: " << size << "\treps: " << samples.size() << "\tns/op: " << mean << " +- " << sqrt(variance) << "\tmin: " << min << std::endl;
+}
+
+#endif
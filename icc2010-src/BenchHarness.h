@@ -0,0 +1,53 @@
+#ifndef BENCHHARNESS_H
+#define BENCHHARNESS_H
+
+#include <fstream>
+#include <vector>
+#include <chrono>
+
+/*
+ * Times benchmark kernels and writes one CSV row per kernel and size:
+ *   kernel,size,reps,ops,mean_ns_per_op,stddev_ns_per_op,min_ns_per_op
+ * Each kernel is repeated up to the given number of times, stopping early
+ * (after at least two) once the time limit for that kernel and size is used
+ * up. Kernels return a checksum, which is summed so the compiler cannot
+ * optimise the work away.
+ */
+class BenchHarness
+{
+	public:
+		BenchHarness(const char *csv_path, int _reps, double _max_seconds);
+		long getChecksum() const;
+		
+		/*
+		 * Runs setup() untimed and then kernel() timed for each repetition,
+		 * kernel() doing ops operations
+		 */
+		template <class Setup, class Kernel>
+		void run(const char *kernel_name, int size, long ops, Setup setup, Kernel kernel)
+		{
+			std::vector<double> samples;
+			double total = 0;
+			for(int r=0;r<reps && (r<2 || total<max_seconds);r++)
+			{
+				setup();
+				std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+				checksum += kernel();
+				std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+				double seconds = std::chrono::duration<double>(t1 - t0).count();
+				total += seconds;
+				samples.push_back(seconds * 1e9 / (double)ops);
+			}
+			record(kernel_name, size, ops, samples);
+		}
+	
+	private:
+		void record(const char *kernel_name, int size, long ops, const std::vector<double> &samples);
+		
+		std::ofstream csv;
+		int reps;
+		double max_seconds;
+		long checksum;
+};
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef BIASTABLE_CC
+#define BIASTABLE_CC
+
+#include <cmath>
+
+#include "BiasTable.h"
+
+/*
+ * Takes the bias weights and exponents from the parameters and fills
+ * the tables for small requirements and hop counts
+ */
+void BiasTable::initialize(const Parameters &params)
+{
+	a1 = params.a1; b11 = params.b11; b12 = params.b12;
+	a2 = params.a2; b21 = params.b21; b22 = params.b22;
+	g = params.g;
+	
+	flow.clear();
+	hop.clear();
+	growFlow(63);
+	growHop(15);
+}
+
+/*
+ * Returns the mixed-bias score of a link with the given requirement whose
+ * sending router is the given number of hops from its GW. The first part
+ * is biased against greedy flows (larger requirements count for less) and
+ * the second against flows which travel many hops.
+ */
+double BiasTable::score(int requirement, int hops)
+{
+	if(requirement >= (int)flow.size())
+		growFlow(requirement);
+	if(hops >= (int)hop.size())
+		growHop(hops);
+	
+	return flow[requirement] + requirement * hop[hops];
+}
+
+/*
+ * Extends the flow table to at least the given requirement, doubling its size
+ */
+void BiasTable::growFlow(int requirement)
+{
+	int r = flow.size();
+	int size = r > 0 ? r : 1;
+	while(size <= requirement)
+		size *= 2;
+	
+	for(flow.resize(size); r < size; r++)
+		flow[r] = r == 0 ? 0 : g * (a1 * pow(r, 1 - b11) + (1 - a1) * pow(r, 1 - b12));
+}
+
+/*
+ * Extends the hop table to at least the given hop count, doubling its size
+ */
+void BiasTable::growHop(int hops)
+{
+	int h = hop.size();
+	int size = h > 0 ? h : 1;
+	while(size <= hops)
+		size *= 2;
+	
+	for(hop.resize(size); h < size; h++)
+		hop[h] = (1 - g) * (a2 * pow(h + 1, -b21) + (1 - a2) * pow(h + 1, -b22));
+}
+
+#endif
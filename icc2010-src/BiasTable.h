@@ -0,0 +1,33 @@
+#ifndef BIASTABLE_H
+#define BIASTABLE_H
+
+#include <vector>
+
+#include "Parameters.h"
+
+/*
+ * Lookup tables for the mixed-bias link scores. The bias powers only
+ * depend on the (integer) link requirement and hop count, so they are
+ * computed once and then indexed while the cliques are scored, instead
+ * of calling pow for every link in every frame. The tables grow when a
+ * larger requirement or hop count is seen.
+ */
+class BiasTable
+{
+	public:
+		void initialize(const Parameters &params);
+		double score(int requirement, int hops);
+	
+	private:
+		void growFlow(int requirement);
+		void growHop(int hops);
+		
+		double a1, b11, b12, a2, b21, b22, g;
+		
+		//flow[r] = g * (a1 * r^(1-b11) + (1-a1) * r^(1-b12))
+		std::vector<double> flow;
+		//hop[h] = (1-g) * (a2 * (h+1)^-b21 + (1-a2) * (h+1)^-b22)
+		std::vector<double> hop;
+};
+
+#endif
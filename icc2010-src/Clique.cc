@@ -40,6 +40,17 @@ std::vector<Clique> Clique::decompose()
 
 
 std::vector<Clique> Clique::decompose()
+{
+	ScheduleBudget unlimited;
+	return decompose(unlimited);
+}
+
+/*
+ * Returns every subset of the clique, charging the budget one operation
+ * per subset. Stops as soon as the budget runs out, returning the subsets
+ * made so far.
+ */
+std::vector<Clique> Clique::decompose(ScheduleBudget &budget)
 {
 	status.clear();
 	
@@ -48,7 +59,7 @@ std::vector<Clique> Clique::decompose()
 		status.push_back(false);
 	}
 	
-	return recursive_decompose(links.size());
+	return recursive_decompose(links.size(), budget);
 }
 
 void Clique::exclude(int i)
@@ -63,12 +74,15 @@ void Clique::include(int i)
 		status[i-1] = true;
 }
 
-std::vector<Clique> Clique::recursive_decompose(int last)
+std::vector<Clique> Clique::recursive_decompose(int last, ScheduleBudget &budget)
 {
 	std::vector<Clique> subset;
 	
 	if(last == 0)
 	{
+		if(!budget.spend(1))
+			return subset;
+		
 		Clique c;
 		for(int i=0; i<(int)status.size(); i++)
 		{
@@ -81,10 +95,12 @@ std::vector<Clique> Clique::recursive_decompose(int last)
 	{
 		std::vector<Clique> subsets;
 		exclude(last);
-		subsets = recursive_decompose(last-1);
+		subsets = recursive_decompose(last-1, budget);
 		subset.insert(subset.begin(), subsets.begin(), subsets.end());
+		if(budget.exhausted())
+			return subset;
 		include(last);
-		subsets = recursive_decompose(last-1);
+		subsets = recursive_decompose(last-1, budget);
 		subset.insert(subset.begin(), subsets.begin(), subsets.end());
 	}
 	
@@ -94,7 +110,7 @@ std::vector<Clique> Clique::recursive_decompose(int last)
 /*
  * Displays a clique
  */
-void Clique::display()
+void Clique::display() const
 {
 	std::cout << "  Clique: " << std::endl;
 	for(int x=0; x<(int)links.size(); x++)
@@ -107,7 +123,7 @@ void Clique::display()
  * Returns true if clique1 and clique2 are equivalent, ie have all of the 
  * same links
  */
-bool Clique::equivalent(Clique c2)
+bool Clique::equivalent(const Clique &c2) const
 {
 	//search c2 for all links in c1
 	for(int x=0;x<(int)links.size();x++)
@@ -142,7 +158,7 @@ bool Clique::equivalent(Clique c2)
  * Returns true if clique1 and clique2 intersection, ie they share at
  * least one common link
  */
-bool Clique::intersect(Clique c2)
+bool Clique::intersect(const Clique &c2) const
 {
 	//search c2 for all links in c1
 	for(int x=0;x<(int)links.size();x++)
@@ -170,7 +186,7 @@ bool Clique::intersect(Clique c2)
 /*
  * Returns the gain for a given clique
  */
-int Clique::getGain()
+int Clique::getGain() const
 {
 	int gain=0; int max=0;
 	for(int x=0;x<(int)links.size();x++)
@@ -183,10 +199,27 @@ int Clique::getGain()
 	return gain - max;
 }
 
+/*
+ * Returns the gain of the clique using the mixed-bias scores of its links
+ * instead of their requirements
+ */
+double Clique::getBiasedGain() const
+{
+	double gain=0; double max=0;
+	for(int x=0;x<(int)links.size();x++)
+	{
+		double weight = links[x].bias;
+		if(weight > max)
+			max = weight;
+		gain += weight;
+	}
+	return gain - max;
+}
+
 /*
  * Returns the maximum weight for a given clique
  */
-int Clique::getWeight()
+int Clique::getWeight() const
 {
 	int max=0;
 	for(int x=0;x<(int)links.size();x++)
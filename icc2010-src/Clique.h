@@ -3,17 +3,20 @@
 
 #include <vector>
 #include "Link.h"
+#include "ScheduleBudget.h"
 
 class Clique
 {
 	public:
-		void display();
-		bool equivalent(Clique c2);
-		bool intersect(Clique c2);
-		int getGain();
-		int getWeight();
+		void display() const;
+		bool equivalent(const Clique &c2) const;
+		bool intersect(const Clique &c2) const;
+		int getGain() const;
+		double getBiasedGain() const;
+		int getWeight() const;
 		std::vector <Clique> decompose();
-		std::vector<Clique> recursive_decompose(int last);
+		std::vector <Clique> decompose(ScheduleBudget &budget);
+		std::vector<Clique> recursive_decompose(int last, ScheduleBudget &budget);
 		void exclude(int i);
 		void include(int i);
 		std::vector <Link> links;
@@ -0,0 +1,113 @@
+#ifndef COLORING_CC
+#define COLORING_CC
+
+#include <set>
+#include <tuple>
+
+#include "Coloring.h"
+
+/*
+ * Constructor for a colouring of the active links, in DSATUR order when
+ * _dsatur is set and largest first otherwise
+ */
+Coloring::Coloring(const std::vector<Link> &_active, const std::vector< std::vector<int> > &_conflicts, bool _dsatur, bool _mixed_bias) : active(_active), conflicts(_conflicts)
+{
+	dsatur = _dsatur;
+	mixed_bias = _mixed_bias;
+}
+
+/*
+ * Colours every link and returns one clique per colour
+ */
+std::vector<Clique> Coloring::generate()
+{
+	seen.assign(active.size(), std::vector<int>());
+	colours.assign(active.size(), -1);
+	weights.clear();
+	
+	//uncoloured links by (saturation, priority, degree), largest first and then lowest index
+	typedef std::tuple<int, double, int, int> Key;
+	std::set<Key> uncoloured;
+	std::vector<int> saturation(active.size(), 0);
+	for(int x=0;x<(int)active.size();x++)
+		uncoloured.insert(Key(0, -getPriority(x), -(int)conflicts[x].size(), x));
+	
+	while(!uncoloured.empty())
+	{
+		int x = std::get<3>(*uncoloured.begin());
+		uncoloured.erase(uncoloured.begin());
+		
+		int c = pickColour(x);
+		colours[x] = c;
+		if(active[x].requirement > weights[c])
+			weights[c] = active[x].requirement;
+		
+		//the conflicts which had not seen this colour yet become more saturated
+		for(int n=0;n<(int)conflicts[x].size();n++)
+		{
+			int y = conflicts[x][n];
+			if(colours[y] != -1)
+				continue;
+			bool taken = false;
+			for(int s=0;s<(int)seen[y].size() && !taken;s++)
+				taken = seen[y][s] == c;
+			if(taken)
+				continue;
+			seen[y].push_back(c);
+			
+			if(dsatur)
+			{
+				uncoloured.erase(Key(-saturation[y], -getPriority(y), -(int)conflicts[y].size(), y));
+				saturation[y]++;
+				uncoloured.insert(Key(-saturation[y], -getPriority(y), -(int)conflicts[y].size(), y));
+			}
+		}
+	}
+	
+	std::vector<Clique> schedule(weights.size());
+	for(int x=0;x<(int)active.size();x++)
+		schedule[colours[x]].links.push_back(active[x]);
+	return schedule;
+}
+
+/*
+ * Returns the colour which lengthens the frame least for the link, the
+ * lowest such colour on a tie, or a new colour if every one is taken
+ */
+int Coloring::pickColour(int x)
+{
+	std::vector<char> taken(weights.size(), false);
+	for(int s=0;s<(int)seen[x].size();s++)
+		taken[seen[x][s]] = true;
+	
+	int best = -1;
+	int best_increase = 0;
+	for(int c=0;c<(int)weights.size();c++)
+	{
+		if(taken[c])
+			continue;
+		int increase = active[x].requirement > weights[c] ? active[x].requirement - weights[c] : 0;
+		if(best == -1 || increase < best_increase)
+		{
+			best = c;
+			best_increase = increase;
+		}
+	}
+	
+	if(best == -1)
+	{
+		best = weights.size();
+		weights.push_back(0);
+	}
+	return best;
+}
+
+/*
+ * Returns how early the link should be coloured, its requirement or its mixed-bias score
+ */
+double Coloring::getPriority(int x) const
+{
+	return mixed_bias ? active[x].bias : active[x].requirement;
+}
+
+#endif
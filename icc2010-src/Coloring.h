@@ -0,0 +1,36 @@
+#ifndef COLORING_H
+#define COLORING_H
+
+#include <vector>
+
+#include "Link.h"
+#include "Clique.h"
+
+/*
+ * Scheduler which builds the rounds by colouring the conflict graph of the
+ * active links instead of enumerating cliques. Every colour is one round and
+ * a link joins the round where it lengthens the frame the least. Links are
+ * coloured in DSATUR order (most differently coloured conflicts first) or
+ * simply largest first, by requirement or by mixed-bias score. The rounds are
+ * returned as cliques, the same as Simulation::generateSchedule.
+ */
+class Coloring
+{
+	public:
+		Coloring(const std::vector<Link> &_active, const std::vector< std::vector<int> > &_conflicts, bool _dsatur, bool _mixed_bias);
+		std::vector<Clique> generate();
+	
+	private:
+		int pickColour(int x);
+		double getPriority(int x) const;
+		
+		const std::vector<Link> &active;
+		const std::vector< std::vector<int> > &conflicts;	//conflicting links of each link, by index into active
+		bool dsatur, mixed_bias;
+		
+		std::vector< std::vector<int> > seen;	//colours already taken by each link's conflicts
+		std::vector<int> colours;				//colour of each link (-1 when uncoloured)
+		std::vector<int> weights;				//largest requirement in each colour
+};
+
+#endif
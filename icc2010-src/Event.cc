@@ -31,24 +31,24 @@ Event::Event(int _type, int _source, int _destination, double _time, double _sta
  * Determine which Event has a lower time
  * for the priority queue (note a > b causes lowest numbers to be on top of queue)
  */
-bool operator<(Event a, Event b)
+bool operator<(const Event &a, const Event &b)
 {
   return a.getTime() > b.getTime();
 }
 
-int Event::getType()
+int Event::getType() const
 { return type;}
 
-int Event::getSource()
+int Event::getSource() const
 { return source;}
 
-int Event::getDestination()
+int Event::getDestination() const
 { return destination;}
 
-double Event::getTime()
+double Event::getTime() const
 { return time;}
 
-double Event::getStartTime()
+double Event::getStartTime() const
 { return start_time;}
 
 #endif
@@ -16,16 +16,16 @@ class Event
 		Event();
 		Event(int _type, int _source, int _destination, double _time, double _start_time);
 		
-		int getType();
-		int getSource();
-		int getDestination();
-		double getTime();
-		double getStartTime();
+		int getType() const;
+		int getSource() const;
+		int getDestination() const;
+		double getTime() const;
+		double getStartTime() const;
 	private:
 		int type, source, destination;
 		double time, start_time;
 };
 
-bool operator<(Event a, Event b);
+bool operator<(const Event &a, const Event &b);
 
 #endif
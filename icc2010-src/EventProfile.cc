@@ -0,0 +1,84 @@
+#ifndef EVENTPROFILE_CC
+#define EVENTPROFILE_CC
+
+#include "EventProfile.h"
+#include <iostream>
+
+static const char *event_names[PROFILE_EVENT_TYPES] = {"NEW", "HOP", "DROP", "SUCCESS", "SCHEDULE", "P_START", "P_STOP"};
+
+EventProfile::EventProfile()
+{
+	reset();
+}
+
+/*
+ * Clears the counts and starts measuring the TSC rate again
+ */
+void EventProfile::reset()
+{
+	for(int type=0;type<PROFILE_EVENT_TYPES;type++)
+	{
+		counts[type] = 0;
+		totals[type] = 0;
+		for(int bucket=0;bucket<PROFILE_BUCKETS;bucket++)
+			histogram[type][bucket] = 0;
+	}
+	start_ticks = ticks();
+	started = std::chrono::steady_clock::now();
+}
+
+/*
+ * Records one handled event of the given type which took elapsed ticks
+ */
+void EventProfile::add(int type, unsigned long long elapsed)
+{
+	int bucket = 0;
+	while(bucket < PROFILE_BUCKETS-1 && (elapsed >> bucket) > 1)
+		bucket++;
+	
+	counts[type]++;
+	totals[type] += elapsed;
+	histogram[type][bucket]++;
+}
+
+/*
+ * Adds the events of another profile, e.g. of replications run on other
+ * threads. The ticks are converted with the TSC rate of this one.
+ */
+void EventProfile::merge(const EventProfile &other)
+{
+	for(int type=0;type<PROFILE_EVENT_TYPES;type++)
+	{
+		counts[type] += other.counts[type];
+		totals[type] += other.totals[type];
+		for(int bucket=0;bucket<PROFILE_BUCKETS;bucket++)
+			histogram[type][bucket] += other.histogram[type][bucket];
+	}
+}
+
+/*
+ * Displays the count, total and mean handler time of every event type
+ * seen, followed by its histogram as upper bound in ns: count
+ */
+void EventProfile::display() const
+{
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+	unsigned long long elapsed = ticks() - start_ticks;
+	double ns_per_tick = (elapsed > 0) ? seconds * 1e9 / (double)elapsed : 0;
+	
+	std::cout << "Event Profile:" << std::endl;
+	for(int type=0;type<PROFILE_EVENT_TYPES;type++)
+	{
+		if(counts[type] == 0)
+			continue;
+		std::cout << "  " << event_names[type] << " Count: " << counts[type] << " Total: " << totals[type] * ns_per_tick / 1e6 << "ms"
+				<< " Mean: " << totals[type] * ns_per_tick / (double)counts[type] << "ns" << std::endl;
+		std::cout << "   ";
+		for(int bucket=0;bucket<PROFILE_BUCKETS;bucket++)
+			if(histogram[type][bucket] > 0)
+				std::cout << " <" << (long long)((double)(2ULL << bucket) * ns_per_tick) << "ns: " << histogram[type][bucket];
+		std::cout << std::endl;
+	}
+}
+
+#endif
@@ -0,0 +1,211 @@
+#ifndef EVENTQUEUE_CC
+#define EVENTQUEUE_CC
+
+#include "EventQueue.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+/*
+ * Construct an empty queue using double times
+ */
+EventQueue::EventQueue()
+{
+	ticks_per_second = 0;
+	count = 0;
+	last = 0;
+	front = 0;
+}
+
+/*
+ * Returns true if there are no events left
+ */
+bool EventQueue::empty() const
+{ return count == 0; }
+
+/*
+ * Returns the number of events waiting in the queue
+ */
+int EventQueue::size() const
+{ return count; }
+
+/*
+ * Returns the number of ticks per second (0 when using double times)
+ */
+double EventQueue::getResolution() const
+{ return ticks_per_second; }
+
+/*
+ * Returns a copy of the earliest event
+ */
+Event EventQueue::top()
+{
+	if(ticks_per_second == 0)
+	{
+		const Entry &entry = heap.front();
+		return makeEvent(entry.time, entry.type, entry.payload);
+	}
+	
+	refill();
+	const TickEntry &entry = buckets[0][front];
+	return makeEvent((double)entry.tick / ticks_per_second, entry.type, entry.payload);
+}
+
+/*
+ * Switches between double times (0) and integer ticks with the given
+ * number of ticks per second. Only allowed while the queue is empty.
+ */
+void EventQueue::setResolution(double _ticks_per_second)
+{
+	if(count != 0)
+	{
+		std::cout << "Error, the event queue resolution can only be changed while it is empty" << std::endl;
+		exit(255);
+	}
+	ticks_per_second = _ticks_per_second;
+	clear();
+}
+
+/*
+ * Adds an event, reusing a free payload record if there is one
+ */
+void EventQueue::push(const Event &E)
+{
+	unsigned int index = newPayload(E);
+	count++;
+	
+	if(ticks_per_second == 0)
+	{
+		Entry entry;
+		entry.time = E.getTime();
+		entry.payload = index;
+		entry.type = E.getType();
+		heap.push_back(entry);
+		std::push_heap(heap.begin(), heap.end(), Later());
+		return;
+	}
+	
+	//events are never scheduled before the current time, but rounding
+	//could put one a tick early, so keep the keys monotone
+	TickEntry entry;
+	long long tick = llround(E.getTime() * ticks_per_second);
+	entry.tick = tick < (long long)last ? last : (unsigned long long)tick;
+	entry.payload = index;
+	entry.type = E.getType();
+	buckets[bucketOf(entry.tick)].push_back(entry);
+}
+
+/*
+ * Removes the earliest event and frees its payload record
+ */
+void EventQueue::pop()
+{
+	count--;
+	
+	if(ticks_per_second == 0)
+	{
+		free_payloads.push_back(heap.front().payload);
+		std::pop_heap(heap.begin(), heap.end(), Later());
+		heap.pop_back();
+		return;
+	}
+	
+	refill();
+	free_payloads.push_back(buckets[0][front].payload);
+	front++;
+	if(front == buckets[0].size())
+	{
+		buckets[0].clear();
+		front = 0;
+	}
+}
+
+/*
+ * Removes every event but keeps the memory for reuse
+ */
+void EventQueue::clear()
+{
+	heap.clear();
+	for(int b=0; b<65; b++)
+		buckets[b].clear();
+	last = 0;
+	front = 0;
+	count = 0;
+	payloads.clear();
+	free_payloads.clear();
+}
+
+/*
+ * Stores the payload of an event in a free record and returns its index
+ */
+unsigned int EventQueue::newPayload(const Event &E)
+{
+	unsigned int index;
+	if(free_payloads.empty())
+	{
+		index = payloads.size();
+		payloads.push_back(Payload());
+	}
+	else
+	{
+		index = free_payloads.back();
+		free_payloads.pop_back();
+	}
+	
+	Payload &payload = payloads[index];
+	payload.start_time = E.getStartTime();
+	payload.source = E.getSource();
+	payload.destination = E.getDestination();
+	return index;
+}
+
+/*
+ * Rebuilds an Event from a queue entry and its payload record
+ */
+Event EventQueue::makeEvent(double time, int type, unsigned int payload) const
+{
+	const Payload &p = payloads[payload];
+	return Event(type, p.source, p.destination, time, p.start_time);
+}
+
+/*
+ * Bucket 0 holds ticks equal to last, otherwise one more than the index
+ * of the highest bit where the tick differs from last
+ */
+int EventQueue::bucketOf(unsigned long long tick) const
+{
+	if(tick == last)
+		return 0;
+	return 64 - __builtin_clzll(tick ^ last);
+}
+
+/*
+ * Makes sure buckets[0] holds the earliest events. If it has run out,
+ * the first non-empty bucket is split around its smallest tick, which
+ * becomes the new last; every entry in it lands in a lower bucket.
+ * Entries keep their relative order, so equal ticks stay first in,
+ * first out.
+ */
+void EventQueue::refill()
+{
+	if(!buckets[0].empty())
+		return;
+	
+	int b = 1;
+	while(buckets[b].empty())
+		b++;
+	
+	std::vector<TickEntry> &bucket = buckets[b];
+	unsigned long long minimum = bucket[0].tick;
+	for(int e=1; e<(int)bucket.size(); e++)
+		if(bucket[e].tick < minimum)
+			minimum = bucket[e].tick;
+	
+	last = minimum;
+	for(int e=0; e<(int)bucket.size(); e++)
+		buckets[bucketOf(bucket[e].tick)].push_back(bucket[e]);
+	bucket.clear();
+}
+
+#endif
@@ -0,0 +1,86 @@
+#ifndef EVENTQUEUE_H
+#define EVENTQUEUE_H
+
+#include <vector>
+
+#include "Event.h"
+
+/*
+ * Priority queue of Events ordered by time (earliest on top).
+ * 
+ * The heap only holds a 16 byte entry per event: the time key, the event
+ * type and the index of a payload record (source, destination and start
+ * time) kept in a side table. Heap comparisons and moves therefore stay
+ * within one cache line, and payload records are recycled through a free
+ * list instead of being reallocated.
+ * 
+ * With a tick resolution set, event times are rounded to whole ticks as
+ * they are pushed and the events are kept in a radix heap instead of the
+ * binary heap. Since simulation time never goes backwards, the radix heap
+ * only ever compares integer keys against the last one popped, and events
+ * at the same tick come out in the order they were pushed.
+ */
+class EventQueue
+{
+	public:
+		EventQueue();
+		
+		bool empty() const;
+		int size() const;
+		double getResolution() const;
+		Event top();
+		
+		void setResolution(double _ticks_per_second);
+		void push(const Event &E);
+		void pop();
+		void clear();
+	
+	private:
+		struct Entry
+		{
+			double time;
+			unsigned int payload;
+			int type;
+		};
+		
+		struct TickEntry
+		{
+			unsigned long long tick;
+			unsigned int payload;
+			int type;
+		};
+		
+		struct Payload
+		{
+			double start_time;
+			int source, destination;
+		};
+		
+		//note a > b causes lowest times to be on top of the heap
+		struct Later
+		{
+			bool operator()(const Entry &a, const Entry &b) const
+			{ return a.time > b.time; }
+		};
+		
+		unsigned int newPayload(const Event &E);
+		Event makeEvent(double time, int type, unsigned int payload) const;
+		int bucketOf(unsigned long long tick) const;
+		void refill();
+		
+		double ticks_per_second;		//0 for double times and the binary heap
+		int count;
+		
+		//binary heap (double times)
+		std::vector<Entry> heap;
+		
+		//radix heap (tick times): bucket b > 0 holds ticks whose highest bit differing from last is b-1
+		std::vector<TickEntry> buckets[65];
+		unsigned long long last;		//tick of the last event popped
+		unsigned int front;					//next entry of buckets[0] to pop
+		
+		std::vector<Payload> payloads;
+		std::vector<unsigned int> free_payloads;
+};
+
+#endif
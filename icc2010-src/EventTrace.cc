@@ -0,0 +1,181 @@
+#ifndef EVENTTRACE_CC
+#define EVENTTRACE_CC
+
+#include "EventTrace.h"
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+static_assert(sizeof(TraceRecord) == 32, "TraceRecord must have no padding");
+
+std::atomic<bool> EventTrace::active(false);
+
+struct TraceBuffer
+{
+	TraceRecord records[EVENT_TRACE_RECORDS];
+	int count;
+};
+
+//the full buffers waiting for the flush thread, in the order they were handed over, and the written ones kept for reuse
+static std::mutex trace_lock;
+static std::condition_variable trace_ready;
+static std::vector<TraceBuffer *> full_buffers, spare_buffers;
+static bool stopping = false;
+static FILE *trace_file = NULL;
+static std::thread flusher;
+static std::atomic<int> runs(0);
+
+static void handOff(TraceBuffer *buffer)
+{
+	std::lock_guard<std::mutex> lock(trace_lock);
+	if(trace_file == NULL)
+	{
+		delete buffer;
+		return;
+	}
+	full_buffers.push_back(buffer);
+	trace_ready.notify_one();
+}
+
+static TraceBuffer *takeSpare()
+{
+	TraceBuffer *buffer = NULL;
+	{
+		std::lock_guard<std::mutex> lock(trace_lock);
+		if(!spare_buffers.empty())
+		{
+			buffer = spare_buffers.back();
+			spare_buffers.pop_back();
+		}
+	}
+	if(buffer == NULL)
+		buffer = new TraceBuffer;
+	buffer->count = 0;
+	return buffer;
+}
+
+//the calling thread's buffer, handed over when the thread ends
+struct LocalTraceBuffer
+{
+	TraceBuffer *buffer;
+	LocalTraceBuffer() : buffer(NULL) {}
+	~LocalTraceBuffer() { if(buffer != NULL) handOff(buffer); buffer = NULL; }
+};
+
+static thread_local LocalTraceBuffer local_buffer;
+
+/*
+ * Writes the full buffers as they arrive, until close()
+ */
+static void flush()
+{
+	std::vector<TraceBuffer *> writing;
+	std::unique_lock<std::mutex> lock(trace_lock);
+	while(true)
+	{
+		trace_ready.wait(lock, []{ return !full_buffers.empty() || stopping; });
+		if(full_buffers.empty())
+			break;
+		writing.swap(full_buffers);
+		
+		lock.unlock();
+		for(unsigned int b=0;b<writing.size();b++)
+			fwrite(writing[b]->records, sizeof(TraceRecord), writing[b]->count, trace_file);
+		lock.lock();
+		
+		spare_buffers.insert(spare_buffers.end(), writing.begin(), writing.end());
+		writing.clear();
+	}
+}
+
+/*
+ * Starts recording to path. Later calls keep the first file, so every
+ * scenario of a sweep goes into one trace, told apart by the runs.
+ */
+void EventTrace::open(const std::string &path)
+{
+	if(active.load())
+		return;
+	
+	trace_file = fopen(path.c_str(), "wb");
+	if(trace_file == NULL)
+	{
+		std::cout << "Error, could not write the event trace " << path << ". Simulation ending." << std::endl;
+		exit(255);
+	}
+	TraceHeader header;
+	memcpy(header.magic, EVENT_TRACE_MAGIC, sizeof(header.magic));
+	header.version = EVENT_TRACE_VERSION;
+	header.record_size = sizeof(TraceRecord);
+	fwrite(&header, sizeof(header), 1, trace_file);
+	
+	flusher = std::thread(flush);
+	active.store(true);
+	atexit(close);
+}
+
+/*
+ * Returns the number of a new run, for its records
+ */
+int EventTrace::beginRun()
+{
+	int run = runs++;
+	if(run >= EVENT_TRACE_RUNS)
+	{
+		std::cout << "Error, the event trace can only tell " << EVENT_TRACE_RUNS << " runs apart" << std::endl;
+		exit(255);
+	}
+	return run;
+}
+
+void EventTrace::record(int run, int type, double time, int source, int destination, int packet, double delay)
+{
+	TraceBuffer *buffer = local_buffer.buffer;
+	if(buffer == NULL)
+		buffer = local_buffer.buffer = takeSpare();
+	
+	TraceRecord &r = buffer->records[buffer->count++];
+	r.time = time;
+	r.delay = delay;
+	r.source = source;
+	r.destination = destination;
+	r.packet = packet;
+	r.event = ((unsigned int)run << 8) | ((unsigned int)type & 0xff);
+	
+	if(buffer->count == EVENT_TRACE_RECORDS)
+	{
+		handOff(buffer);
+		local_buffer.buffer = NULL;
+	}
+}
+
+/*
+ * Writes everything handed over and closes the file, at exit. By then
+ * every thread, the main one included, has handed over its last buffer.
+ */
+void EventTrace::close()
+{
+	if(!active.exchange(false))
+		return;
+	
+	{
+		std::lock_guard<std::mutex> lock(trace_lock);
+		stopping = true;
+		trace_ready.notify_one();
+	}
+	flusher.join();
+	
+	std::lock_guard<std::mutex> lock(trace_lock);
+	fclose(trace_file);
+	trace_file = NULL;
+	for(unsigned int b=0;b<spare_buffers.size();b++)
+		delete spare_buffers[b];
+	spare_buffers.clear();
+}
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef EVENTTRACE_H
+#define EVENTTRACE_H
+
+#include <string>
+#include <atomic>
+
+/*
+ * One handled event in the binary trace, 32 bytes with no padding so the
+ * file can be read in place (see TraceReader.h)
+ */
+struct TraceRecord
+{
+	double time;		//when the event was handled
+	double delay;		//age of the packet when the event was handled, 0 if none
+	int source;			//MR the event happened at
+	int destination;	//MR at the other end (the next hop of a HOP, the GW of a NEW, SUCCESS or DROP), -1 if none
+	int packet;			//id of the packet, the order it was created in its run (from 1), -1 if none
+	unsigned int event;	//the type in the low 8 bits, the run above them
+	
+	int type() const { return event & 0xff; }	//NEW to P_STOP, see Event.h
+	int run() const { return event >> 8; }		//run the event belongs to, in the order the runs started
+};
+
+//the file starts with this header, then the records
+struct TraceHeader
+{
+	char magic[8];		//EVENT_TRACE_MAGIC
+	unsigned int version;
+	unsigned int record_size;
+};
+
+#define EVENT_TRACE_MAGIC "WMNTRACE"
+#define EVENT_TRACE_VERSION 2
+#define EVENT_TRACE_RUNS (1 << 24)		//runs a trace can tell apart
+#define EVENT_TRACE_RECORDS 32768		//records per buffer (1 MiB)
+
+/*
+ * Writes every handled event as a fixed-size binary record, for offline
+ * analysis without DEBUGGING. Every thread fills its own buffer and hands
+ * it to a background thread when it is full, so recording an event is a
+ * few stores and the run never waits on the disk. Nothing is recorded
+ * until open() is called (EVENT_TRACE=path), and the buffers left are
+ * written when the program exits.
+ */
+class EventTrace
+{
+	public:
+		static void open(const std::string &path);
+		static bool enabled() { return active.load(std::memory_order_relaxed); }
+		static int beginRun();
+		static void record(int run, int type, double time, int source, int destination, int packet, double delay);
+		static void close();
+	
+	private:
+		static std::atomic<bool> active;
+};
+
+#endif
@@ -11,12 +11,13 @@ Link::Link(int _first, int _second)
 	first = _first;
 	second = _second;
 	requirement = 0;
+	bias = 0;
 }
 
 /*
  * Displays the MRs in a link and the requirement
  */
-void Link::display()
+void Link::display() const
 {
 	std::cout << "  LS: (" << first << "," << second << ") Requirement: " << requirement << std::endl;
 }
@@ -24,7 +25,7 @@ void Link::display()
 /*
  * Returns true if two links are equivalent, ie they have the same MRs in them)
  */
-bool Link::equivalent(Link l2)
+bool Link::equivalent(const Link &l2) const
 {
 	if((first == l2.first && second == l2.second) || (first == l2.second && second == l2.first))
 		return true;
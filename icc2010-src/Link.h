@@ -8,8 +8,9 @@ class Link
 	public:
 		Link(int _first, int _second);
 		int first, second, requirement;
-		bool equivalent(Link l2);
-		void display();
+		double bias;		//mixed-bias score of the requirement, see BiasTable.h
+		bool equivalent(const Link &l2) const;
+		void display() const;
 	private:
 };
 
@@ -0,0 +1,171 @@
+#ifndef LOCALSEARCH_CC
+#define LOCALSEARCH_CC
+
+#include <algorithm>
+
+#include "LocalSearch.h"
+
+/*
+ * Improves the schedule in place, trying at most max_iterations moves and
+ * swaps, and returns by how many hop delays the frame got shorter. The
+ * conflicts index the links in the order they appear in the schedule.
+ */
+int LocalSearch::improve(std::vector<Clique> &schedule, const std::vector< std::vector<int> > &_conflicts, int max_iterations)
+{
+	conflicts = &_conflicts;
+	items.clear();
+	rounds.clear();
+	for(int c=0;c<(int)schedule.size();c++)
+	{
+		for(int l=0;l<(int)schedule[c].links.size();l++)
+		{
+			items.push_back(schedule[c].links[l]);
+			rounds.push_back(c);
+		}
+	}
+	
+	int num_rounds = schedule.size();
+	stamps.assign(items.size(), 0);
+	heaps.assign(num_rounds, std::vector<Entry>());
+	for(int x=0;x<(int)items.size();x++)
+		place(x, rounds[x]);
+	
+	int saved = 0;
+	int iterations = 0;
+	bool improved = true;
+	while(improved && iterations < max_iterations)
+	{
+		improved = false;
+		for(int x=0;x<(int)items.size() && iterations < max_iterations;x++)
+		{
+			int a = rounds[x];
+			int requirement = items[x].requirement;
+			for(int b=0;b<num_rounds && iterations < max_iterations;b++)
+			{
+				if(b == a)
+					continue;
+				
+				//move x on its own
+				iterations++;
+				if(!conflictsWith(x, b, -1))
+				{
+					int change = topWithout(a, x) - top(a) + std::max(top(b), requirement) - top(b);
+					if(change < 0)
+					{
+						place(x, b);
+						saved -= change;
+						improved = true;
+						break;
+					}
+				}
+				
+				//swap x with each link y in b
+				bool swapped = false;
+				std::vector<Entry> members = heaps[b];
+				for(int m=0;m<(int)members.size() && !swapped && iterations < max_iterations;m++)
+				{
+					int y = members[m].item;
+					if(members[m].stamp != stamps[y] || conflictsWith(x, b, y) || conflictsWith(y, a, x))
+						continue;
+					iterations++;
+					int new_a = std::max(topWithout(a, x), items[y].requirement);
+					int new_b = std::max(topWithout(b, y), requirement);
+					int change = new_a + new_b - top(a) - top(b);
+					if(change < 0)
+					{
+						place(x, b);
+						place(y, a);
+						saved -= change;
+						swapped = true;
+					}
+				}
+				if(swapped)
+				{
+					improved = true;
+					break;
+				}
+			}
+		}
+	}
+	
+	//rebuild the cliques, leaving out rounds which were emptied
+	std::vector<Clique> result(num_rounds);
+	for(int x=0;x<(int)items.size();x++)
+		result[rounds[x]].links.push_back(items[x]);
+	schedule.clear();
+	for(int c=0;c<num_rounds;c++)
+	{
+		if(result[c].links.size() > 0)
+			schedule.push_back(result[c]);
+	}
+	return saved;
+}
+
+/*
+ * Heap entries are ordered by requirement
+ */
+bool LocalSearch::Entry::operator<(const Entry &e) const
+{
+	return requirement < e.requirement;
+}
+
+/*
+ * Returns true if x conflicts with any link in the round apart from ignore
+ */
+bool LocalSearch::conflictsWith(int x, int round, int ignore) const
+{
+	const std::vector<int> &near = (*conflicts)[x];
+	for(int n=0;n<(int)near.size();n++)
+	{
+		if(near[n] != ignore && rounds[near[n]] == round)
+			return true;
+	}
+	return false;
+}
+
+/*
+ * Returns the weight of the round, dropping stale entries off its heap
+ */
+int LocalSearch::top(int round)
+{
+	std::vector<Entry> &heap = heaps[round];
+	while(!heap.empty() && heap.front().stamp != stamps[heap.front().item])
+	{
+		std::pop_heap(heap.begin(), heap.end());
+		heap.pop_back();
+	}
+	return heap.empty() ? 0 : heap.front().requirement;
+}
+
+/*
+ * Returns the weight the round would have without x
+ */
+int LocalSearch::topWithout(int round, int x)
+{
+	int weight = top(round);
+	std::vector<Entry> &heap = heaps[round];
+	if(heap.empty() || heap.front().item != x)
+		return weight;
+	
+	Entry first = heap.front();
+	std::pop_heap(heap.begin(), heap.end());
+	heap.pop_back();
+	weight = top(round);
+	heap.push_back(first);
+	std::push_heap(heap.begin(), heap.end());
+	return weight;
+}
+
+/*
+ * Puts x into the round, which makes any entry it has elsewhere stale
+ */
+void LocalSearch::place(int x, int round)
+{
+	stamps[x]++;
+	rounds[x] = round;
+	Entry e = {items[x].requirement, x, stamps[x]};
+	heaps[round].push_back(e);
+	std::push_heap(heaps[round].begin(), heaps[round].end());
+}
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef LOCALSEARCH_H
+#define LOCALSEARCH_H
+
+#include <vector>
+
+#include "Link.h"
+#include "Clique.h"
+
+/*
+ * Post-pass which shortens a schedule by moving single links to another
+ * round, or swapping two links between rounds, whenever that lowers the sum
+ * of the round weights and keeps every round conflict-free. Each round keeps
+ * a max-heap of its requirements, so the change in length of a move comes
+ * from the heap tops without rescanning the rounds. Links which have moved
+ * are left in the old heap and skipped once they reach the top.
+ */
+class LocalSearch
+{
+	public:
+		int improve(std::vector<Clique> &schedule, const std::vector< std::vector<int> > &_conflicts, int max_iterations);
+	
+	private:
+		struct Entry
+		{
+			int requirement, item, stamp;
+			bool operator<(const Entry &e) const;
+		};
+		
+		bool conflictsWith(int x, int round, int ignore) const;
+		int top(int round);
+		int topWithout(int round, int x);
+		void place(int x, int round);
+		
+		std::vector<Link> items;				//every link in the schedule, round by round
+		std::vector<int> rounds;				//round of each link
+		std::vector<int> stamps;				//bumped on every move, older heap entries are stale
+		const std::vector< std::vector<int> > *conflicts;
+		std::vector< std::vector<Entry> > heaps;
+};
+
+#endif
@@ -0,0 +1,129 @@
+/*
+ * Scaling benchmark: runs complete simulations over a grid of numbers of
+ * MRs, GWs and MCs, with and without FS and at two arrival rates, and
+ * prints one JSON report to stdout. For each point it gives the wall
+ * time, events handled per second, the peak resident memory, the deepest
+ * the event queue got and the share of the time spent building schedules.
+ * Every point runs in its own child process so its peak memory is its own,
+ * and is stopped after POINT_TIME_LIMIT.
+ *
+ * usage: ./wmn-macrobench [config file] [KEY=value ...] > macrobench.json
+ * (the first scenario is the base for every point, see Parameters.h)
+ */
+
+#include <iostream>
+#include <cstdio>
+#include <chrono>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+
+#include "Simulation.h"
+
+#define POINT_TIME_LIMIT 300
+
+//what a child process sends back for one point
+struct PointResult
+{
+	double wall_seconds, schedule_seconds, pdr;
+	long events;
+	unsigned int peak_queue;
+};
+
+/*
+ * Runs every repeat of the point, with the output thrown away
+ */
+static PointResult runPoint(int num_mr, int num_gw, const Parameters &params)
+{
+	std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now();
+	Simulation sim(num_mr, num_gw, params);
+	
+	PointResult result;
+	result.wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+	result.schedule_seconds = sim.getScheduleSeconds();
+	result.pdr = sim.getAveragePDR();
+	result.events = sim.getEvents();
+	result.peak_queue = sim.getPeakQueue();
+	return result;
+}
+
+/*
+ * Runs the point in a child process and writes its JSON object
+ */
+static void measurePoint(int num_mr, int num_gw, const Parameters &params, bool first)
+{
+	int fds[2];
+	if(pipe(fds) != 0)
+	{
+		std::cout << "Error, could not create a pipe" << std::endl;
+		exit(255);
+	}
+	
+	std::cout.flush();	//or the child would write out our buffer again
+	pid_t child = fork();
+	if(child == 0)
+	{
+		close(fds[0]);
+		if(!freopen("/dev/null", "w", stdout))
+			_exit(255);
+		alarm(POINT_TIME_LIMIT);
+		PointResult result = runPoint(num_mr, num_gw, params);
+		_exit(write(fds[1], &result, sizeof(result)) == sizeof(result) ? 0 : 255);
+	}
+	close(fds[1]);
+	
+	PointResult result;
+	bool finished = read(fds[0], &result, sizeof(result)) == sizeof(result);
+	close(fds[0]);
+	
+	int status;
+	struct rusage usage;
+	wait4(child, &status, 0, &usage);
+	
+	std::cout << (first ? "" : ",") << std::endl;
+	std::cout << "    {\"num_mr\": " << num_mr << ", \"num_gw\": " << num_gw << ", \"num_mc\": " << params.num_mc
+			<< ", \"fs_enabled\": " << (params.fs_enabled ? "true" : "false") << ", \"mb_enabled\": " << (params.mb_enabled ? "true" : "false")
+			<< ", \"mean\": " << params.mean << ", \"peak_rss_kb\": " << usage.ru_maxrss;
+	if(finished)
+	{
+		std::cout << ", \"wall_seconds\": " << result.wall_seconds << ", \"events\": " << result.events
+				<< ", \"events_per_second\": " << result.events / result.wall_seconds << ", \"peak_queue\": " << result.peak_queue
+				<< ", \"schedule_share\": " << result.schedule_seconds / result.wall_seconds << ", \"pdr\": " << result.pdr << ", \"timed_out\": false}";
+	}
+	else
+		std::cout << ", \"timed_out\": true}";
+	
+	std::cerr << "MR " << num_mr << " GW " << num_gw << " MC " << params.num_mc << " FS " << params.fs_enabled << " MEAN " << params.mean
+			<< (finished ? " done" : " timed out") << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+	Parameters base = readScenarios(argc, argv)[0];
+	const int routers[] = {10, 20, 40};
+	const int gateways[] = {1, 2};
+	const int clients[] = {1, 2};			//multiples of the base NUM_MC
+	const double rates[] = {1, 0.5};		//multiples of the base MEAN
+	
+	std::cout << "{" << std::endl << "  \"simulator\": \"icc2010\"," << std::endl;
+	std::cout << "  \"repeats\": " << base.repeats << ", \"num_packets\": " << base.num_packets << ", \"scheduler\": " << base.scheduler << "," << std::endl;
+	std::cout << "  \"points\": [";
+	
+	bool first = true;
+	for(int r=0;r<(int)(sizeof(routers)/sizeof(routers[0]));r++)
+		for(int g=0;g<(int)(sizeof(gateways)/sizeof(gateways[0]));g++)
+			for(int c=0;c<(int)(sizeof(clients)/sizeof(clients[0]));c++)
+				for(int fs=0;fs<2;fs++)
+					for(int m=0;m<(int)(sizeof(rates)/sizeof(rates[0]));m++)
+					{
+						Parameters params = base;
+						params.num_mc = base.num_mc * clients[c];
+						params.fs_enabled = fs;
+						params.mean = base.mean * rates[m];
+						measurePoint(routers[r], gateways[g], params, first);
+						first = false;
+					}
+	
+	std::cout << std::endl << "  ]" << std::endl << "}" << std::endl;
+	return 0;
+}
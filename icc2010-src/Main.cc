@@ -0,0 +1,136 @@
+/*
+ * C++ Discrete Event Simulation
+ * for Wireless Mesh Networks
+ * by Jason Ernst
+ * University of Guelph, Guelph ON, Canada
+ * 
+ * Command line entry point, see Simulation.cc for the simulation itself
+ */
+
+#include "Simulation.h"
+#include "Timeline.h"
+#include "EventTrace.h"
+#include "PerfCounters.h"
+#include <map>
+#include <tuple>
+#include <algorithm>
+#include <ctime>
+
+/*
+ * Returns the topology for the given number of MRs and GWs in the given
+ * scenario, generating it only the first time so scenarios with the same
+ * layout (e.g. with and without FS) share it. With PERF_COUNTERS the
+ * hardware counters of generating it are displayed.
+ */
+typedef std::tuple<int, int, int, int, int, double> TopologyKey;
+static std::shared_ptr<const Topology> getTopology(std::map<TopologyKey, std::shared_ptr<const Topology> > &topologies, int num_mr, int num_gw, const Parameters &params)
+{
+	std::shared_ptr<const Topology> &topology = topologies[TopologyKey(num_mr, num_gw, params.max_x, params.max_y, params.num_mc, params.range)];
+	if(!topology)
+	{
+		PerfCounters counters;
+		if(params.perf_counters)
+			counters.open();
+		PerfSample started = counters.sample();
+		topology = std::make_shared<const Topology>(params.max_x, params.max_y, num_mr, num_gw, params.num_mc, params.range);
+		counters.add(PERF_TOPOLOGY, started, counters.sample());
+		counters.display(0);
+	}
+	return topology;
+}
+
+/*
+ * The delay and PDR of every repeat of one scenario at a sweep point,
+ * kept with CRN for the paired differences
+ */
+struct SweepResult
+{
+	std::string scenario;
+	std::vector<double> delays, pdrs;
+};
+
+/*
+ * Displays, at every sweep point, the mean difference of each scenario
+ * to the first one there with its 95% confidence interval, pairing the
+ * repeats which drew the same random numbers. The pairs take out the
+ * run to run noise the scenarios share, so the intervals are much
+ * narrower than those of two independent sets of repeats.
+ */
+static void displayPairedDifferences(const std::map<TopologyKey, std::vector<SweepResult> > &results)
+{
+	if(results.empty())
+		return;
+	std::cout << "Paired Differences (common random numbers):" << std::endl;
+	for(std::map<TopologyKey, std::vector<SweepResult> >::const_iterator point = results.begin(); point != results.end(); point++)
+	{
+		const std::vector<SweepResult> &scenarios = point->second;
+		for(int s=1;s<(int)scenarios.size();s++)
+		{
+			RunningStat delay, pdr;
+			int pairs = std::min(scenarios[0].delays.size(), scenarios[s].delays.size());
+			for(int r=0;r<pairs;r++)
+			{
+				delay.add(scenarios[s].delays[r] - scenarios[0].delays[r]);
+				pdr.add(scenarios[s].pdrs[r] - scenarios[0].pdrs[r]);
+			}
+			std::cout << "MR: " << std::get<0>(point->first) << " GW: " << std::get<1>(point->first) << " " << scenarios[s].scenario << " - " << scenarios[0].scenario
+					<< ": Delay " << delay.getMean() << " +/- " << delay.getHalfWidth() << " PDR " << pdr.getMean() << " +/- " << pdr.getHalfWidth() << " (" << pairs << " pairs)" << std::endl;
+		}
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	srand48(time(NULL)); //randomize the generator
+	long started = time(NULL);
+	std::cout << "C++ Discrete Event Simulation" << std::endl;
+	std::cout << "Jason Ernst, University of Guelph" << std::endl;
+	std::cout << "Version 0.4, January 2009" << std::endl;
+	std::cout << "---------------------------------" << std::endl;
+
+	std::vector<Parameters> scenarios = readScenarios(argc, argv);
+	std::map<TopologyKey, std::shared_ptr<const Topology> > topologies;
+	std::map<TopologyKey, std::vector<SweepResult> > results;
+	
+	for(int s=0;s<(int)scenarios.size();s++)
+	{
+		Parameters &params = scenarios[s];
+		if(argc > 1)
+			params.display();
+		if(!params.trace_file.empty())
+			Timeline::open(params.trace_file);
+		if(!params.event_trace.empty())
+			EventTrace::open(params.event_trace);
+		Timeline::Span scenario_span("scenario", s);
+		
+		//loop over the numbers of mesh routers
+		for(int num_mr = params.min_mr; num_mr <= params.max_mr; num_mr += params.mr_step)
+		{
+			//run each mesh router result with each number of gws
+			for(int num_gw = params.min_gw; num_gw <= params.max_gw; num_gw++)
+			{
+				Timeline::Span job_span("sweep job", num_mr);
+				
+				//with CRN every scenario seeds the repeats at this point alike
+				TopologyKey key(num_mr, num_gw, params.max_x, params.max_y, params.num_mc, params.range);
+				Parameters point = params;
+				if(params.crn)
+					point.seed = ((params.seed != 0) ? params.seed : started) + ((long)num_mr << 20) + num_gw;
+				
+				Simulation sim(getTopology(topologies, num_mr, num_gw, params), point);
+				if(params.crn)
+				{
+					SweepResult result;
+					result.scenario = params.name;
+					result.delays = sim.getRepeatDelays();
+					result.pdrs = sim.getRepeatPDRs();
+					results[key].push_back(result);
+				}
+			}
+		}
+	}
+	displayPairedDifferences(results);
+	Simulation::stopReplicationThreads();
+	
+	return 0;
+}
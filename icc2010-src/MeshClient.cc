@@ -32,27 +32,27 @@ MeshClient::MeshClient(double _x, double _y, int _id, int _mr)
 	mr = _mr;
 }
 
-void MeshClient::display()
+void MeshClient::display() const
 {
 	std::cout << "    MC:" << id << " X: " << x << " Y: " << y << " Nearest MR: " << mr << std::endl;
 }
 
-int MeshClient::getMR()
+int MeshClient::getMR() const
 {
 	return mr;
 }
 
-int MeshClient::getId()
+int MeshClient::getId() const
 {
 	return id;
 }
 
-double MeshClient::getX()
+double MeshClient::getX() const
 {
 	return x;
 }
 
-double MeshClient::getY()
+double MeshClient::getY() const
 {
 	return y;
 }
@@ -9,12 +9,12 @@ class MeshClient
 		MeshClient();
 		MeshClient(double _x, double _y, int _id, int _mr);
 		
-		void display();
+		void display() const;
 		
-		int getId();
-		int getMR();
-		double getX();
-		double getY();
+		int getId() const;
+		int getMR() const;
+		double getX() const;
+		double getY() const;
 		
 		~MeshClient();
 	private:
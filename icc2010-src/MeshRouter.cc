@@ -42,7 +42,7 @@ MeshRouter::MeshRouter(double _x, double _y, int _id)
 /*
  * Displays all the important information within a MR
  */
-void MeshRouter::display()
+void MeshRouter::display() const
 {
 	std::cout << "    MR:" << id << " X: " << x << " Y: " << y << " isGW: " << gw << " NearestGW: " << nearest << " #Hops: " << hops << " PER: " << permission << " BUF: " << buffer << std::endl;
 }
@@ -90,7 +90,7 @@ void MeshRouter::setHops(int _hops)
 /*
  * Returns the contents of the MR buffer
  */
-int MeshRouter::getBuffer()
+int MeshRouter::getBuffer() const
 {
 	return buffer;
 }
@@ -98,7 +98,7 @@ int MeshRouter::getBuffer()
 /*
  * Returns the ID of the Mesh Router
  */
-int MeshRouter::getId()
+int MeshRouter::getId() const
 {
 	return id;
 }
@@ -106,7 +106,7 @@ int MeshRouter::getId()
 /*
  * Returns the x-coordinate of the Mesh Router
  */
-double MeshRouter::getX()
+double MeshRouter::getX() const
 {
 	return x;
 }
@@ -114,7 +114,7 @@ double MeshRouter::getX()
 /*
  * Returns the y-coordinate of the Mesh Router
  */
-double MeshRouter::getY()
+double MeshRouter::getY() const
 {
 	return y;
 }
@@ -122,7 +122,7 @@ double MeshRouter::getY()
 /*
  * Returns true if the Mesh Router is a Gateway
  */
-bool MeshRouter::isGW()
+bool MeshRouter::isGW() const
 {
 	return gw;
 }
@@ -130,7 +130,7 @@ bool MeshRouter::isGW()
 /*
  * Returns true if the router has permission to transmit
  */
-bool MeshRouter::hasPermission()
+bool MeshRouter::hasPermission() const
 {
 	return permission;
 }
@@ -138,7 +138,7 @@ bool MeshRouter::hasPermission()
 /*
  * Returns the nearest GW to the given Mesh Router
  */
-int MeshRouter::getNearestGW()
+int MeshRouter::getNearestGW() const
 {
 	return nearest;
 }
@@ -146,7 +146,7 @@ int MeshRouter::getNearestGW()
 /*
  * Returns the number of hops to the nearest GW
  */
-int MeshRouter::getHops()
+int MeshRouter::getHops() const
 {
 	return hops;
 }
@@ -12,20 +12,20 @@ class MeshRouter
 		MeshRouter(double _x, double _y, int _id);
 		
 		void setPermission(bool _permission);
-		void display();
+		void display() const;
 		void setBuffer(int _buffer);
 		void setGW();
 		void setNearestGW(int _nearest);
 		void setHops(int _hops);
 		
-		bool hasPermission();
-		bool isGW();
-		double getX();
-		double getY();
-		int getId();
-		int getNearestGW();
-		int getHops();
-		int getBuffer();
+		bool hasPermission() const;
+		bool isGW() const;
+		double getX() const;
+		double getY() const;
+		int getId() const;
+		int getNearestGW() const;
+		int getHops() const;
+		int getBuffer() const;
 		
 	private:
 		double x,y;
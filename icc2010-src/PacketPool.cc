@@ -0,0 +1,74 @@
+#ifndef PACKETPOOL_CC
+#define PACKETPOOL_CC
+
+#include "PacketPool.h"
+#include <iostream>
+#include <cstdlib>
+
+/*
+ * Preallocates room for capacity packets and frees all of them
+ */
+void PacketPool::resize(int capacity)
+{
+	packets.resize(capacity);
+	free_packets.resize(capacity);
+	
+	//hand out the lowest ids first
+	for(int p=0;p<capacity;p++)
+		free_packets[p] = capacity-1-p;
+	used = 0;
+}
+
+/*
+ * Takes a free record for a new packet and returns its id
+ */
+int PacketPool::allocate(int id, int source, int destination, double start_time)
+{
+	if(free_packets.empty())
+	{
+		std::cout << "Error, the packet pool is exhausted (" << packets.size() << " packets). Simulation ending." << std::endl;
+		exit(255);
+	}
+	
+	int p = free_packets.back();
+	free_packets.pop_back();
+	packets[p].id = id;
+	packets[p].source = source;
+	packets[p].destination = destination;
+	packets[p].start_time = start_time;
+	packets[p].hops = 0;
+	used++;
+	return p;
+}
+
+/*
+ * Returns a finished packet's record to the pool
+ */
+void PacketPool::release(int packet)
+{
+	free_packets.push_back(packet);
+	used--;
+}
+
+/*
+ * Returns the record of the given packet
+ */
+Packet &PacketPool::operator[](int packet)
+{
+	return packets[packet];
+}
+
+const Packet &PacketPool::operator[](int packet) const
+{
+	return packets[packet];
+}
+
+/*
+ * Returns the number of packets currently in use
+ */
+int PacketPool::size() const
+{
+	return used;
+}
+
+#endif
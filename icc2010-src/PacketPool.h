@@ -0,0 +1,41 @@
+#ifndef PACKETPOOL_H
+#define PACKETPOOL_H
+
+#include <vector>
+
+/*
+ * A packet in flight: the order it was created in its run, the MR it
+ * entered the mesh at, the GW it is headed for, the time it was created
+ * and how many hops it has made
+ */
+struct Packet
+{
+	int id;
+	int source, destination;
+	double start_time;
+	int hops;
+};
+
+/*
+ * Fixed pool of packet records. Every packet in a run lives in one of the
+ * pool's slots and is referred to by its index, so creating and finishing
+ * packets never touches the allocator.
+ */
+class PacketPool
+{
+	public:
+		void resize(int capacity);
+		int allocate(int id, int source, int destination, double start_time);
+		void release(int packet);
+		
+		Packet &operator[](int packet);
+		const Packet &operator[](int packet) const;
+		int size() const;
+	
+	private:
+		std::vector<Packet> packets;
+		std::vector<int> free_packets;
+		int used;
+};
+
+#endif
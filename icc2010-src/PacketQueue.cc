@@ -0,0 +1,96 @@
+#ifndef PACKETQUEUE_CC
+#define PACKETQUEUE_CC
+
+#include "PacketQueue.h"
+#include <iostream>
+#include <cstdlib>
+
+/*
+ * Empties every queue and makes room for _capacity packets per MR
+ */
+void PacketQueue::resize(int num_routers, int _capacity)
+{
+	if(_capacity < 1)
+	{
+		std::cout << "Error, each MR must be able to queue at least one packet. Simulation ending." << std::endl;
+		exit(255);
+	}
+	capacity = _capacity;
+	slots.assign(num_routers * capacity, -1);
+	priorities.assign(num_routers * capacity, 0);
+	head.assign(num_routers, 0);
+	count.assign(num_routers, 0);
+}
+
+/*
+ * Adds the packet to the back of the router's queue (first in, first
+ * out). The caller must make sure the queue is not full.
+ */
+void PacketQueue::push(int router, int packet)
+{
+	slots[slot(router, count[router])] = packet;
+	count[router]++;
+}
+
+/*
+ * Inserts the packet behind every queued packet with a lower or equal
+ * priority value, but never ahead of the packet being sent. The caller
+ * must make sure the queue is not full.
+ */
+void PacketQueue::push(int router, int packet, double priority)
+{
+	int position = count[router];
+	while(position > 1 && priorities[slot(router, position-1)] > priority)
+	{
+		slots[slot(router, position)] = slots[slot(router, position-1)];
+		priorities[slot(router, position)] = priorities[slot(router, position-1)];
+		position--;
+	}
+	slots[slot(router, position)] = packet;
+	priorities[slot(router, position)] = priority;
+	count[router]++;
+}
+
+/*
+ * Removes and returns the packet at the front of the router's queue
+ */
+int PacketQueue::pop(int router)
+{
+	int packet = front(router);
+	head[router] = (head[router]+1) % capacity;
+	count[router]--;
+	return packet;
+}
+
+bool PacketQueue::empty(int router) const
+{
+	return count[router] == 0;
+}
+
+bool PacketQueue::full(int router) const
+{
+	return count[router] == capacity;
+}
+
+int PacketQueue::size(int router) const
+{
+	return count[router];
+}
+
+/*
+ * Returns the packet the router is currently sending
+ */
+int PacketQueue::front(int router) const
+{
+	return slots[slot(router, 0)];
+}
+
+/*
+ * Index into the flat array of the given position in the router's queue
+ */
+int PacketQueue::slot(int router, int position) const
+{
+	return router*capacity + (head[router]+position) % capacity;
+}
+
+#endif
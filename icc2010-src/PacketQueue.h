@@ -0,0 +1,36 @@
+#ifndef PACKETQUEUE_H
+#define PACKETQUEUE_H
+
+#include <vector>
+
+/*
+ * Bounded queue of packet ids for every MR. All of the queues are ring
+ * buffers carved out of one flat array (capacity slots per MR), so they
+ * are allocated once per run and never grow.
+ * 
+ * The packet at the front is the one the MR is currently sending, so
+ * ordered (priority) pushes never place a packet ahead of it.
+ */
+class PacketQueue
+{
+	public:
+		void resize(int num_routers, int _capacity);
+		void push(int router, int packet);
+		void push(int router, int packet, double priority);
+		int pop(int router);
+		
+		bool empty(int router) const;
+		bool full(int router) const;
+		int size(int router) const;
+		int front(int router) const;
+	
+	private:
+		int slot(int router, int position) const;
+		
+		int capacity;
+		std::vector<int> slots;
+		std::vector<double> priorities;
+		std::vector<int> head, count;
+};
+
+#endif
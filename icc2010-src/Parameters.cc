@@ -0,0 +1,302 @@
+#ifndef PARAMETERS_CC
+#define PARAMETERS_CC
+
+#include "Parameters.h"
+#include <iostream>
+#include <fstream>
+#include <cstdlib>
+#include <cctype>
+
+/*
+ * Default parameters, used for anything a config file or the command
+ * line does not set
+ */
+Parameters::Parameters()
+{
+	name = "default";
+	
+	repeats = 10;
+	precision = 0;
+	max_repeats = 100;
+	threads = 1;
+	seed = 0;
+	crn = false;
+	start = 0.0;
+	end = 300.0;
+	warmup = false;
+	steady_precision = 0;
+	num_packets = 10000;
+	mean = 0.01;
+	hop_delay = 0.01;
+	max_x = 1000;
+	max_y = 1000;
+	num_mc = 250;
+	range = 250;
+	ticks_per_second = 0;
+	wait_lists = false;
+	max_wait_time = 0;
+	queue_capacity = 1;
+	queue_priority = false;
+	scheduler = CLIQUE_SCHEDULER;
+	schedule_ops = 0;
+	schedule_time = 0;
+	local_search = 0;
+	
+	min_mr = 10;
+	max_mr = 50;
+	mr_step = 5;
+	min_gw = 1;
+	max_gw = 5;
+	fs_enabled = false;
+	mb_enabled = false;
+	
+	a1 = 0.2;
+	b11 = 5;
+	b12 = 1;
+	a2 = 0.2;
+	b21 = 5;
+	b22 = 1;
+	g = 0.5;
+	
+	debugging = false;
+	profile_events = false;
+	trace_file = "";
+	event_trace = "";
+	perf_counters = false;
+}
+
+/*
+ * Parsers for each type of parameter, returning false on a bad value
+ */
+static bool parseValue(const std::string &value, int &field)
+{
+	char *end;
+	long parsed = strtol(value.c_str(), &end, 10);
+	if(value.empty() || *end != '\0')
+		return false;
+	field = (int)parsed;
+	return true;
+}
+
+static bool parseValue(const std::string &value, long &field)
+{
+	char *end;
+	long parsed = strtol(value.c_str(), &end, 10);
+	if(value.empty() || *end != '\0')
+		return false;
+	field = parsed;
+	return true;
+}
+
+static bool parseValue(const std::string &value, double &field)
+{
+	char *end;
+	double parsed = strtod(value.c_str(), &end);
+	if(value.empty() || *end != '\0')
+		return false;
+	field = parsed;
+	return true;
+}
+
+static bool parseValue(const std::string &value, std::string &field)
+{
+	field = value;
+	return true;
+}
+
+static bool parseValue(const std::string &value, bool &field)
+{
+	if(value == "1" || value == "true" || value == "on")
+		field = true;
+	else if(value == "0" || value == "false" || value == "off")
+		field = false;
+	else
+		return false;
+	return true;
+}
+
+/*
+ * Visitor which sets the parameter named key
+ */
+struct ParameterSetter
+{
+	std::string key, value;
+	bool found;
+	
+	template <class T>
+	void operator()(const char *name, T &field)
+	{
+		if(key != name)
+			return;
+		found = true;
+		if(!parseValue(value, field))
+		{
+			std::cout << "Error, invalid value for " << key << ": " << value << ". Simulation ending." << std::endl;
+			exit(255);
+		}
+	};
+};
+
+/*
+ * Visitor which displays every parameter
+ */
+struct ParameterPrinter
+{
+	template <class T>
+	void operator()(const char *name, T &field)
+	{
+		std::cout << "    " << name << "=" << field << std::endl;
+	};
+};
+
+/*
+ * Sets the parameter with the given key from its text value. Returns
+ * false if there is no such parameter, and exits if the value is bad.
+ */
+bool Parameters::set(const std::string &key, const std::string &value)
+{
+	ParameterSetter setter;
+	setter.key = key;
+	setter.value = value;
+	setter.found = false;
+	visit(setter);
+	return setter.found;
+}
+
+/*
+ * Displays the scenario name and all of its parameters
+ */
+void Parameters::display()
+{
+	ParameterPrinter printer;
+	std::cout << "  Scenario: " << name << std::endl;
+	visit(printer);
+}
+
+/*
+ * Removes leading and trailing whitespace
+ */
+static std::string trim(const std::string &s)
+{
+	unsigned int first = 0;
+	unsigned int last = s.size();
+	while(first < last && isspace(s[first]))
+		first++;
+	while(last > first && isspace(s[last-1]))
+		last--;
+	return s.substr(first, last-first);
+}
+
+/*
+ * Splits a "KEY = value" assignment, exiting with an error naming where
+ * it came from if it is not one
+ */
+static void splitAssignment(const std::string &line, const std::string &where, std::string &key, std::string &value)
+{
+	std::string::size_type equals = line.find('=');
+	if(equals == std::string::npos)
+	{
+		std::cout << "Error, expected KEY=value at " << where << ": " << line << ". Simulation ending." << std::endl;
+		exit(255);
+	}
+	key = trim(line.substr(0, equals));
+	value = trim(line.substr(equals+1));
+}
+
+static void apply(Parameters &p, const std::string &key, const std::string &value, const std::string &where)
+{
+	if(!p.set(key, value))
+	{
+		std::cout << "Error, unknown parameter " << key << " at " << where << ". Simulation ending." << std::endl;
+		exit(255);
+	}
+}
+
+/*
+ * Builds the list of scenarios to simulate from the command line:
+ * 
+ *   wmn-simulator [config.ini ...] [KEY=value ...]
+ * 
+ * A config file holds KEY = value lines (# or ; start a comment). Lines
+ * before the first [section] of each file change the defaults; every
+ * [section] is a scenario which starts from the defaults read so far. KEY=value arguments apply
+ * to every scenario, after the files. With no sections the scenarios are
+ * the original three sweeps: without FS, with FS and with mixed-bias.
+ */
+std::vector<Parameters> readScenarios(int argc, char *argv[])
+{
+	Parameters defaults;
+	std::vector<Parameters> scenarios;
+	std::vector<std::string> overrides;
+	
+	for(int a=1;a<argc;a++)
+	{
+		std::string arg = argv[a];
+		if(arg.find('=') != std::string::npos)
+		{
+			overrides.push_back(arg);
+			continue;
+		}
+		
+		std::ifstream file(arg.c_str());
+		if(!file)
+		{
+			std::cout << "Error, could not open config file " << arg << ". Simulation ending." << std::endl;
+			exit(255);
+		}
+		
+		std::string line;
+		int line_number = 0;
+		bool in_section = false;	//lines before the first section of this file are defaults
+		while(std::getline(file, line))
+		{
+			line_number++;
+			std::string::size_type comment = line.find_first_of("#;");
+			if(comment != std::string::npos)
+				line = line.substr(0, comment);
+			line = trim(line);
+			if(line.empty())
+				continue;
+			
+			//a new scenario, starting from the defaults read so far
+			if(line[0] == '[' && line[line.size()-1] == ']')
+			{
+				scenarios.push_back(defaults);
+				scenarios.back().name = trim(line.substr(1, line.size()-2));
+				in_section = true;
+				continue;
+			}
+			
+			std::string key, value;
+			std::string where = arg + ":" + std::to_string(line_number);
+			splitAssignment(line, where, key, value);
+			apply(in_section ? scenarios.back() : defaults, key, value, where);
+		}
+	}
+	
+	if(scenarios.empty())
+	{
+		defaults.name = "no-fs";
+		scenarios.push_back(defaults);
+		
+		defaults.name = "fs";
+		defaults.fs_enabled = true;
+		scenarios.push_back(defaults);
+		
+		defaults.name = "mixed-bias";
+		defaults.mb_enabled = true;
+		scenarios.push_back(defaults);
+	}
+	
+	for(int s=0;s<(int)scenarios.size();s++)
+		for(int o=0;o<(int)overrides.size();o++)
+		{
+			std::string key, value;
+			splitAssignment(overrides[o], "the command line", key, value);
+			apply(scenarios[s], key, value, "the command line");
+		}
+	
+	return scenarios;
+}
+
+#endif
@@ -0,0 +1,135 @@
+#ifndef PARAMETERS_H
+#define PARAMETERS_H
+
+#include <string>
+#include <vector>
+
+/*
+ * Every tunable knob of a Simulation scenario. The constructor fills in
+ * the defaults, and config files and KEY=value arguments can override any
+ * of them at runtime, so a sweep needs no rebuild. The keys are the names
+ * given to visit() below, e.g. HOPDELAY=0.02.
+ */
+struct Parameters
+{
+	Parameters();
+	
+	bool set(const std::string &key, const std::string &value);
+	void display();
+	
+	/*
+	 * Calls v(key, field) for every parameter, so setting and displaying
+	 * them by name share one list
+	 */
+	template <class Visitor>
+	void visit(Visitor &v)
+	{
+		v("REPEATS", repeats);
+		v("PRECISION", precision);
+		v("MAX_REPEATS", max_repeats);
+		v("THREADS", threads);
+		v("SEED", seed);
+		v("CRN", crn);
+		v("START", start);
+		v("END", end);
+		v("WARMUP", warmup);
+		v("STEADY_PRECISION", steady_precision);
+		v("NUMPACKETS", num_packets);
+		v("MEAN", mean);
+		v("HOPDELAY", hop_delay);
+		v("MAX_X", max_x);
+		v("MAX_Y", max_y);
+		v("NUM_MC", num_mc);
+		v("RANGE", range);
+		v("TICKS_PER_SECOND", ticks_per_second);
+		v("WAIT_LISTS", wait_lists);
+		v("MAX_WAIT_TIME", max_wait_time);
+		v("QUEUE_CAPACITY", queue_capacity);
+		v("QUEUE_PRIORITY", queue_priority);
+		v("SCHEDULER", scheduler);
+		v("SCHEDULE_OPS", schedule_ops);
+		v("LOCAL_SEARCH", local_search);
+		v("SCHEDULE_TIME", schedule_time);
+		v("MIN_MR", min_mr);
+		v("MAX_MR", max_mr);
+		v("MR_STEP", mr_step);
+		v("MIN_GW", min_gw);
+		v("MAX_GW", max_gw);
+		v("FS_ENABLED", fs_enabled);
+		v("MB_ENABLED", mb_enabled);
+		v("A1", a1);
+		v("B11", b11);
+		v("B12", b12);
+		v("A2", a2);
+		v("B21", b21);
+		v("B22", b22);
+		v("G", g);
+		v("DEBUGGING", debugging);
+		v("PROFILE_EVENTS", profile_events);
+		v("TRACE_FILE", trace_file);
+		v("EVENT_TRACE", event_trace);
+		v("PERF_COUNTERS", perf_counters);
+	};
+	
+	std::string name;					//name of the scenario in the config file
+	
+	/* Simulation Parameters */
+	int repeats;						//how many times we should repeat for consistent results
+	double precision;					//repeat until the 95% CIs of delay and PDR are within this fraction of their means (0 repeats exactly REPEATS times)
+	int max_repeats;					//most repeats when repeating to a precision
+	int threads;						//repeats run at once when repeating to a precision
+	long seed;							//of the random numbers of the repeats (0 takes it from the clock)
+	bool crn;							//common random numbers: repeat r at a sweep point offers the same packet arrivals to every scenario (arrivals are then drawn per NEW event only), and the differences to the first scenario are reported in pairs
+	double start;						//start time (s)
+	double end;							//end time (s)
+	bool warmup;						//detect the warm-up of each repeat with MSER-5 and report the delay without it (see StreamStats.h)
+	double steady_precision;			//with WARMUP, end a repeat once the 95% CI of its steady-state delay is within this fraction of the mean (0 runs to END or NUMPACKETS)
+	int num_packets;					//number of packets
+	double mean;						//mean inter-arrival time
+	double hop_delay;					//the maximum average delay for each hop
+	int max_x;							//maximum x dimension of the simulation environment in meters
+	int max_y;							//maximum y dimension of the simulation environment in meters
+	int num_mc;							//the number of MCs in the simulation
+	double range;						//maximum communication range of MRs and MCs in meters
+	double ticks_per_second;			//integer event times with this resolution, e.g. 1e9 for ns (0 uses double times)
+	bool wait_lists;					//park blocked HOPs until permission is given instead of retrying every hop delay
+	double max_wait_time;				//drop a parked packet once it has waited longer than this (0 waits indefinitely)
+	int queue_capacity;					//packets each MR can hold, including the one being sent
+	bool queue_priority;				//serve the oldest queued packets first instead of in arrival order
+	int scheduler;						//which engine builds the schedules, see below
+	int schedule_ops;					//operation budget for each schedule (0 is unlimited)
+	double schedule_time;				//wall-clock budget in seconds for each schedule (0 is unlimited)
+	int local_search;					//moves and swaps tried to shorten each schedule (0 turns the local search off)
+	
+	/* Sweep, every number of MRs from min_mr to max_mr with every number of GWs from min_gw to max_gw */
+	int min_mr, max_mr, mr_step;
+	int min_gw, max_gw;
+	bool fs_enabled, mb_enabled;
+	
+	/* Mixed-Bias Parameters */
+	double a1;							//alpha 1 -> proportion to use b11 bias (1-a1) uses b12
+	double b11;							//strong bias exponent against greedy flows
+	double b12;							//weak bias exponent against greedy flows (proportional fair component when b12=1)
+	
+	double a2;							//alpha 2 -> proportion to use b21 bias (1-a2) uses b22
+	double b21;							//strong bias exponent against many hops
+	double b22;							//weak bias exponent against many hops
+	
+	double g;							//gamma -> what proportion of resources to assign to each strategy
+	
+	/* Simulation Options */
+	bool debugging;						//print every event as it is handled
+	bool profile_events;				//time the handling of every event, by type (see EventProfile.h)
+	std::string trace_file;				//write a Chrome trace of the simulator phases here at exit (see Timeline.h)
+	std::string event_trace;			//write every event to this binary file (see EventTrace.h)
+	bool perf_counters;					//read the hardware counters around each phase (see PerfCounters.h)
+};
+
+/* Schedulers */
+#define CLIQUE_SCHEDULER 0		//greedy over all the compatible cliques
+#define DSATUR_SCHEDULER 1		//DSATUR colouring of the conflict graph (see Coloring.h)
+#define LRF_SCHEDULER 2			//largest requirement (or mixed-bias score) first colouring
+
+std::vector<Parameters> readScenarios(int argc, char *argv[]);
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef PERFCOUNTERS_H
+#define PERFCOUNTERS_H
+
+#define PERF_CYCLES 0
+#define PERF_INSTRUCTIONS 1
+#define PERF_CACHE_MISSES 2
+#define PERF_BRANCH_MISSES 3
+#define PERF_COUNTERS 4
+
+//phases of a Simulation the counters are split into
+#define PERF_TOPOLOGY 0		//building a Topology
+#define PERF_DISPATCH 1		//the event loop apart from SCHEDULE events
+#define PERF_SCHEDULING 2		//SCHEDULE events
+#define PERF_PHASES 3
+
+//counter values at one moment
+struct PerfSample
+{
+	unsigned long long values[PERF_COUNTERS];
+};
+
+/*
+ * Hardware counters (cycles, instructions, cache misses and branch
+ * misses) of this thread read with Linux perf_event_open, accumulated
+ * per phase. open() fails where the kernel or the machine does not
+ * provide them, and an unopened PerfCounters samples zeros, so callers
+ * need not check.
+ */
+class PerfCounters
+{
+	public:
+		PerfCounters();
+		~PerfCounters();
+		
+		bool open();
+		bool isOpen() const { return leader >= 0; }
+		PerfSample sample() const;
+		void add(int phase, const PerfSample &from, const PerfSample &to);
+		void reset(int phase);
+		void merge(const PerfCounters &other);
+		void display(long events) const;
+		
+	private:
+		PerfCounters(const PerfCounters &);
+		PerfCounters &operator=(const PerfCounters &);
+		
+		int leader;					//group leader fd, -1 until opened
+		int fds[PERF_COUNTERS];
+		int slots[PERF_COUNTERS];	//position of each counter in a group read, -1 if not counted
+		int opened;
+		PerfSample totals[PERF_PHASES];
+		long samples[PERF_PHASES];	//how many times each phase was added to
+};
+
+#endif
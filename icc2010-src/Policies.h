@@ -0,0 +1,125 @@
+#ifndef POLICIES_H
+#define POLICIES_H
+
+#include <iostream>
+#include <vector>
+
+#include "Clique.h"
+#include "EventProfile.h"
+#include "EventTrace.h"
+
+/*
+ * Policies the Simulation run loop is compiled with. Simulation::selectRun()
+ * picks the instantiation for the scenario's parameters, so none of these
+ * are tested per event and the unused paths compile out.
+ */
+
+/*
+ * Scheduling policies. Without FS every MR always has permission and no
+ * requirement tables are kept. With FS the requirements are tracked and
+ * SCHEDULE events hand out permission, using the schedule generate()
+ * returns.
+ */
+struct NoScheduling
+{
+	static const bool enabled = false;
+	
+	//never called, there are no SCHEDULE events without FS
+	template <class Sim>
+	static std::vector<Clique> generate(Sim &)
+	{ return std::vector<Clique>(); }
+};
+
+struct FairScheduling
+{
+	static const bool enabled = true;
+	
+	template <class Sim>
+	static std::vector<Clique> generate(Sim &sim)
+	{ return sim.generateSchedule(false); }
+};
+
+//FS with the cliques ranked by the mixed-bias link scores (see BiasTable.h)
+struct MixedBiasScheduling
+{
+	static const bool enabled = true;
+	
+	template <class Sim>
+	static std::vector<Clique> generate(Sim &sim)
+	{ return sim.generateSchedule(true); }
+};
+
+/*
+ * Instrumentation policies: SilentTrace does nothing, DebugTrace prints
+ * every event as it is handled, ProfileTrace times the handling of every
+ * event into an EventProfile, RecordTrace writes every event to the binary
+ * EventTrace
+ */
+struct SilentTrace
+{
+	static unsigned long long startEvent() { return 0; }
+	static void endEvent(EventProfile &, int, unsigned long long) {}
+	static void newPacket(int, int, double) {}
+	static void hop(int, int, double) {}
+	static void noPermission(int, int, double) {}
+	static void drop(int, double) {}
+	static void success(int, double) {}
+	static void schedule(int, double) {}
+	static void permissionStart(int, double) {}
+	static void permissionStop(int, double) {}
+	static int beginRun() { return 0; }
+	static void record(int, int, double, int, int, int, double) {}
+};
+
+struct DebugTrace
+{
+	static unsigned long long startEvent() { return 0; }
+	static void endEvent(EventProfile &, int, unsigned long long) {}
+	
+	static void newPacket(int mc, int mr, double now)
+	{ std::cout << "    New Event, t=" << now << " MC: " << mc << " MR: " << mr << std::endl; }
+	
+	static void hop(int source, int destination, double now)
+	{ std::cout << "    Hop Event, t=" << now << " From MR: " << source << " to MR: " << destination << std::endl; }
+	
+	static void noPermission(int source, int destination, double now)
+	{ std::cout << "    No Permission to send packet, t=" << now << " From MR: " << source << " to MR: " << destination << std::endl; }
+	
+	static void drop(int router, double now)
+	{ std::cout << "    Drop Event, t=" << now << " at MR: " << router << std::endl; }
+	
+	static void success(int router, double now)
+	{ std::cout << "    Success Event, t=" << now << " at MR: " << router << std::endl; }
+	
+	static void schedule(int rounds, double now)
+	{ std::cout << "    Schedule Event, t=" << now << " Rounds: " << rounds << std::endl; }
+	
+	static void permissionStart(int router, double now)
+	{ std::cout << "    Start Permission Event, t=" << now << " at MR: " << router << std::endl; }
+	
+	static void permissionStop(int router, double now)
+	{ std::cout << "    Stop Permission Event, t=" << now << " at MR: " << router << std::endl; }
+	
+	static int beginRun() { return 0; }
+	static void record(int, int, double, int, int, int, double) {}
+};
+
+struct ProfileTrace : SilentTrace
+{
+	static unsigned long long startEvent()
+	{ return EventProfile::ticks(); }
+	
+	static void endEvent(EventProfile &profile, int type, unsigned long long started)
+	{ profile.add(type, EventProfile::ticks() - started); }
+};
+
+struct RecordTrace : SilentTrace
+{
+	static int beginRun()
+	{ return EventTrace::beginRun(); }
+	
+	static void record(int run, int type, double now, int source, int destination, int packet, double delay)
+	{ EventTrace::record(run, type, now, source, destination, packet, delay); }
+};
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef RUNSTATE_CC
+#define RUNSTATE_CC
+
+#include "RunState.h"
+
+/*
+ * Ensures the event queue, wait lists and packet queues are empty (with
+ * room for queue_capacity packets per MR), requirements and statistics
+ * cleared and every MR has the given permission
+ */
+void RunState::reset(int num_mr, int num_ls, bool _permission, int queue_capacity)
+{
+	EQ.clear();
+	waiting.resize(num_mr);
+	queues.resize(num_mr, queue_capacity);
+	packets.resize(num_mr * queue_capacity);
+	permission.assign(num_mr, _permission);
+	requirement.assign(num_ls, 0);
+	
+	delay = 0;
+	drop_delay = 0;
+	packet_counter = 0;
+	success_packets = 0;
+	dropped_packets = 0;
+	schedule_counter = 0;
+	budget_hits = 0;
+	search_saved = 0;
+	schedule_gap = 0;
+	events = 0;
+	peak_queue = 0;
+	schedule_seconds = 0;
+}
+
+#endif
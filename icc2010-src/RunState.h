@@ -0,0 +1,44 @@
+#ifndef RUNSTATE_H
+#define RUNSTATE_H
+
+#include <vector>
+
+#include "EventQueue.h"
+#include "WaitList.h"
+#include "PacketPool.h"
+#include "PacketQueue.h"
+#include "StreamStats.h"
+
+/*
+ * Everything a single Simulation run changes, kept apart from the shared
+ * Topology: the pending events, the packets parked and queued at and the
+ * permission of each MR, the requirement on each link (indexed the same
+ * as Topology::getLS()) and the statistics. reset() clears it in place,
+ * so every run starts clean but reuses the memory of the one before.
+ */
+class RunState
+{
+	public:
+		void reset(int num_mr, int num_ls, bool _permission, int queue_capacity);
+		
+		EventQueue EQ;
+		WaitList waiting;		//HOPs waiting for permission (with WAIT_LISTS)
+		PacketPool packets;
+		PacketQueue queues;
+		std::vector<char> permission;
+		std::vector<int> requirement;
+		WarmupDetector warmup;		//of the delivered delays, filled only with WARMUP
+		int run;					//number of the run in the EventTrace, filled only by RecordTrace
+		
+		//statistics
+		double delay, drop_delay;			//summed over the delivered and over the dropped packets
+		int packet_counter, success_packets, dropped_packets;
+		int schedule_counter, budget_hits;	//budgeted schedules and how many of them were cut short by the budget
+		int search_saved;					//hop delays taken off the schedules by the local search
+		double schedule_gap;				//sum over the schedules of (length - lower bound) / lower bound
+		long events;						//events taken off the queue
+		unsigned int peak_queue;			//most events pending at once
+		double schedule_seconds;			//wall time spent handling SCHEDULE events
+};
+
+#endif
@@ -0,0 +1,98 @@
+#ifndef SCHEDULEBUDGET_CC
+#define SCHEDULEBUDGET_CC
+
+#include "ScheduleBudget.h"
+
+//the clock is only read every this many operations, it costs more than one
+#define CLOCK_INTERVAL 1024
+
+/*
+ * Constructor for an unlimited budget
+ */
+ScheduleBudget::ScheduleBudget()
+{
+	ops = 0;
+	max_ops = 0;
+	max_seconds = 0;
+	hit = false;
+	skipped = false;
+}
+
+/*
+ * Constructor for a budget of _max_ops operations or _max_seconds, whichever runs out first
+ */
+ScheduleBudget::ScheduleBudget(long _max_ops, double _max_seconds)
+{
+	ops = 0;
+	max_ops = _max_ops;
+	max_seconds = _max_seconds;
+	hit = false;
+	skipped = false;
+	if(max_seconds > 0)
+		started = std::chrono::steady_clock::now();
+}
+
+/*
+ * Charges n operations, returns false once the budget is exhausted
+ */
+bool ScheduleBudget::spend(long n)
+{
+	if(hit)
+		return false;
+	
+	long before = ops;
+	ops += n;
+	if(max_ops > 0 && ops > max_ops)
+		hit = true;
+	else if(max_seconds > 0 && before / CLOCK_INTERVAL != ops / CLOCK_INTERVAL)
+	{
+		std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - started;
+		if(elapsed.count() > max_seconds)
+			hit = true;
+	}
+	return !hit;
+}
+
+/*
+ * Returns true if n more operations fit in the operation limit, so a
+ * large step can be skipped before it is started rather than cut short
+ */
+bool ScheduleBudget::affords(long n) const
+{
+	return !hit && (max_ops <= 0 || ops + n <= max_ops);
+}
+
+/*
+ * Returns true once the budget has run out
+ */
+bool ScheduleBudget::exhausted() const
+{
+	return hit;
+}
+
+/*
+ * Records that a step was skipped because it did not fit
+ */
+void ScheduleBudget::skip()
+{
+	skipped = true;
+}
+
+/*
+ * Returns true if the budget ran out or a step was skipped, so the result
+ * is not what an unlimited budget would have given
+ */
+bool ScheduleBudget::cutShort() const
+{
+	return hit || skipped;
+}
+
+/*
+ * Returns the number of operations charged so far
+ */
+long ScheduleBudget::getOps() const
+{
+	return ops;
+}
+
+#endif
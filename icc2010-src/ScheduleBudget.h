@@ -0,0 +1,32 @@
+#ifndef SCHEDULEBUDGET_H
+#define SCHEDULEBUDGET_H
+
+#include <chrono>
+
+/*
+ * Limits the work done building one schedule, either in operations
+ * (cliques generated and compared) or in wall-clock seconds, where 0
+ * means unlimited. Once it is exhausted it stays exhausted and the
+ * scheduler returns the best schedule it has so far.
+ */
+class ScheduleBudget
+{
+	public:
+		ScheduleBudget();
+		ScheduleBudget(long _max_ops, double _max_seconds);
+		
+		bool spend(long n);
+		bool affords(long n) const;
+		bool exhausted() const;
+		void skip();
+		bool cutShort() const;
+		long getOps() const;
+	
+	private:
+		long ops, max_ops;
+		double max_seconds;
+		bool hit, skipped;
+		std::chrono::steady_clock::time_point started;
+};
+
+#endif
@@ -12,101 +12,150 @@
 #define SIMULATION_CC
 
 #include "Simulation.h"
+#include <algorithm>
+#include <chrono>
+#include "WorkerPool.h"
+#include <cmath>
 
-int main()
+/*
+ * Create a new instance of a Simulation with certain parameters set for
+ * the duration of this simulation
+ */
+Simulation::Simulation(int _num_mr, int _num_gw, const Parameters &_params)
 {
-	srand48(time(NULL)); //randomize the generator
-	std::cout << "C++ Discrete Event Simulation" << std::endl;
-	std::cout << "Jason Ernst, University of Guelph" << std::endl;
-	std::cout << "Version 0.4, January 2009" << std::endl;
-	std::cout << "---------------------------------" << std::endl;
+	num_mr = _num_mr;
+	num_gw = _num_gw;
+	num_mc = _params.num_mc;
+	initialize(_params);
+}
 
-	int num_mr, num_gw;
-	
-	
-	/* Simulation Runs without FS */	
-	num_mr = 10;
-	
-	//loop between 10 and 40 mesh routers, incrementing by 5 each time
-	while(num_mr <= 50)
-	{
-		num_gw = 1;
-		
-		//run each mesh router result with gws between 1 and 5
-		while(num_gw <= 5)
-		{
-			Simulation sim = Simulation(num_mr, num_gw, NUM_MC, false, false);
-			num_gw++;
-		}
-		num_mr += 5;
-	}
-		
-	/* Simulation Runs with FS */
-	num_mr = 10;
-	
-	//loop between 10 and 40 mesh routers, incrementing by 5 each time
-	while(num_mr <= 50)
-	{
-		num_gw = 1;
-		
-		//run each mesh router result with gws between 1 and 5
-		while(num_gw <= 5)
-		{
-			Simulation sim = Simulation(num_mr, num_gw, NUM_MC, true, false);
-			num_gw++;
-		}
-		num_mr += 5;
-	}
-	
-	/* Simulation Runs with Mixed-Bias */
-	num_mr = 10;
-	
-	while(num_gw <= 50)
-	{
-		num_gw = 1;
-		
-		//run each mesh router result with gws between 1 and 5
-		while(num_gw <= 5)
-		{
-			Simulation sim = Simulation(num_mr, num_gw, NUM_MC, true, true);
-			num_gw++;
-		}
-		num_mr += 5;
-	}
+/*
+ * Create a new instance of a Simulation which runs on an existing topology
+ * (shared with any other Simulation using it, never copied)
+ */
+Simulation::Simulation(std::shared_ptr<const Topology> _topology, const Parameters &_params)
+{
+	topology = _topology;
+	num_mr = topology->getMR().size();
+	num_gw = topology->getGW().size();
+	num_mc = topology->getMC().size();
+	initialize(_params);
+}
+
+/*
+ * Create a worker for repeatToPrecision(), which runs repeats of the
+ * parent's scenario on its topology without displaying anything. Its
+ * statistics are merged into the parent's afterwards.
+ */
+Simulation::Simulation(const Simulation *parent)
+{
+	topology = parent->topology;
+	num_mr = parent->num_mr;
+	num_gw = parent->num_gw;
+	num_mc = parent->num_mc;
+	current_run = 1;
+	params = parent->params;
+	base_seed = parent->base_seed;
+	seedReplication(base_seed, 0);
+	state.EQ.setResolution(params.ticks_per_second);
+	bias.initialize(params);
+	resetStatistics();
+	delays.reset(topology->getMR().size());
 	
-	return 0;
+	//the counters only follow the thread which opened them
+	if(params.perf_counters && params.threads <= 1)
+		counters.open();
 }
 
 /*
- * Create a new instance of a Simulation with certain parameters set for
- * the duration of this simulation
+ * Sets up the simulation variables and runs the simulation
  */
-Simulation::Simulation(int _num_mr, int _num_gw, int _num_mc, bool _fs_enabled, bool _mb_enabled)
+void Simulation::initialize(const Parameters &_params)
 {
 	//initialize the important simulation variables
 	current_run = 1;
-	num_mr = _num_mr;
-	num_gw = _num_gw;
-	num_mc = _num_mc;
-	fs_enabled = _fs_enabled;
-	mb_enabled = _mb_enabled;
-	srand48(time(NULL));
+	params = _params;
+	base_seed = (params.seed != 0) ? params.seed : time(NULL);
+	seedReplication(base_seed, 0);
+	state.EQ.setResolution(params.ticks_per_second);
+	bias.initialize(params);
+	resetStatistics();
+	if(params.perf_counters)
+		counters.open();
 	
-	//initialize the statistics variables
-	total_delay = 0;
-	total_pdr = 0;
-	
-	std::cout << "New Simulation Instance: MR: " << num_mr << " GW: " << num_gw << " FS_ENABLED: " << fs_enabled << " MB_ENABLED: " << mb_enabled << std::endl;
+	std::cout << "New Simulation Instance: MR: " << num_mr << " GW: " << num_gw << " FS_ENABLED: " << params.fs_enabled << " MB_ENABLED: " << params.mb_enabled << std::endl;
 	
 	start();
 }
 
+/*
+ * Zeroes the totals over the repeats
+ */
+void Simulation::resetStatistics()
+{
+	total_delay = 0;
+	total_pdr = 0;
+	total_drop_delay = 0;
+	total_dropped = 0;
+	run_delay = 0;
+	run_pdr = 0;
+	total_schedules = 0;
+	total_budget_hits = 0;
+	total_search_saved = 0;
+	total_gap = 0;
+	total_events = 0;
+	total_peak_queue = 0;
+	total_schedule_seconds = 0;
+	profile.reset();
+	delay_runs.reset();
+	pdr_runs.reset();
+	steady_runs.reset();
+	repeat_delays.clear();
+	repeat_pdrs.clear();
+}
+
+#define RANDOM_STREAMS 3	//arrivals, hop delays and schedule rounds
+
+/*
+ * Sets an erand48 state to the given stream of replication r of the
+ * repeats started from base, hashing the three (splitmix64) into all 48
+ * bits so that neighbouring replications and streams are not shifted
+ * copies of one another
+ */
+static void hashSeed(unsigned short state[3], long base, int replication, int stream)
+{
+	unsigned long long z = (unsigned long long)base + 0x9E3779B97F4A7C15ULL * (unsigned long long)(RANDOM_STREAMS * replication + stream + 1);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	z = z ^ (z >> 31);
+	state[0] = (unsigned short)(z & 0xFFFF);
+	state[1] = (unsigned short)((z >> 16) & 0xFFFF);
+	state[2] = (unsigned short)((z >> 32) & 0xFFFF);
+}
+
+/*
+ * Restarts the random numbers for replication r of the repeats started
+ * from base. The packet arrivals, the hop delays and the schedule round
+ * lengths have a stream each. With common random numbers (CRN) the
+ * arrivals are only drawn when a NEW event is handled (see run()), so the
+ * configurations compared at a sweep point are offered the same packets
+ * at the same times. The other two streams are consumed in the order each
+ * configuration sends and schedules, so they only line up as far as the
+ * configurations behave alike.
+ */
+void Simulation::seedReplication(long base, int replication)
+{
+	hashSeed(arrival_state, base, replication, 0);
+	hashSeed(delay_state, base, replication, 1);
+	hashSeed(schedule_state, base, replication, 2);
+}
+
 /*
  * Starts the simulation
  */
 void Simulation::start()
 {
-	if(REPEATS < 1)
+	if(params.repeats < 1)
 	{
 		std::cout << "Error, REPEATS must be at least 1" << std::endl;
 		exit(255);
@@ -115,48 +164,193 @@ void Simulation::start()
 	/* Important! Must generate the topology and perform expensive
 	 * calculations here as much as possible to lower computing time
 	 */
-	topology = TopologyHelper(MAX_X, MAX_Y, num_mr, num_gw, num_mc, RANGE);
-	MR = topology.getMR();
+	if(!topology)
+	{
+		PerfSample started = counters.sample();
+		topology = std::make_shared<const Topology>(params.max_x, params.max_y, num_mr, num_gw, num_mc, params.range);
+		counters.add(PERF_TOPOLOGY, started, counters.sample());
+	}
+	delays.reset(topology->getMR().size());
 	displayMRs();
-	GW = topology.getGW();
-	MC = topology.getMC();
-	LS = topology.getLS();
 	//displayLSs();
 	//displayMCs();
 	
-	while(current_run <= REPEATS)
-	{		
-		run();
-		current_run++;
-	}
-	//std::cout << "Final Results, " << REPEATS << " repeats." << std::endl;
-	std::cout << "Average Delay: " << total_delay / REPEATS << " Average PDR: " << total_pdr / REPEATS << std::endl;
+	if(params.precision > 0)
+		repeatToPrecision();
+	else
+		while(current_run <= params.repeats)
+		{		
+			if(params.crn)
+				seedReplication(base_seed, current_run - 1);
+			(this->*selectRun())();
+			current_run++;
+		}
+	//std::cout << "Final Results, " << params.repeats << " repeats." << std::endl;
+	if(params.precision > 0)
+		std::cout << "Repeats: " << delay_runs.getCount() << std::endl;
+	std::cout << "Average Delay: " << getAverageDelay() << " Average PDR: " << getAveragePDR() << std::endl;
+	std::cout << "Dropped: " << total_dropped << " Average Dropped Delay: " << getAverageDropDelay() << std::endl;
+	std::cout << "95% CI: Delay +/- " << delay_runs.getHalfWidth() << " PDR +/- " << pdr_runs.getHalfWidth() << std::endl;
+	delays.display();
+	if(params.warmup && steady_runs.getCount() == 0)
+		std::cout << "Steady-State Delay: insufficient data (MSER-5 needs " << 2 * MSER_GROUPS * MSER_BATCH << " delivered packets per repeat)" << std::endl;
+	else if(params.warmup)
+		std::cout << "Steady-State Delay: " << steady_runs.getMean() << " +/- " << steady_runs.getHalfWidth() << " (MSER-5 warm-up removed, " << steady_runs.getCount() << " repeats)" << std::endl;
+	if(params.local_search > 0)
+		std::cout << "Local Search Saved: " << total_search_saved << " hop delays" << std::endl;
+	if(total_schedules > 0)
+		std::cout << "Schedules: " << total_schedules << " Budget Hits: " << total_budget_hits << " Average Gap: " << total_gap / total_schedules << std::endl;
+	if(params.profile_events)
+		profile.display();
+	counters.display(total_events);
 	//pause();
 }
 
+std::unique_ptr<WorkerPool> Simulation::replication_threads;
+
+/*
+ * Ends the threads the repeats ran on, before the program exits so the
+ * event trace buffers they hold are written
+ */
+void Simulation::stopReplicationThreads()
+{
+	replication_threads.reset();
+}
+
+/*
+ * Repeats until at least REPEATS are done and the 95% CIs of the delay
+ * and PDR are within PRECISION of their means, or MAX_REPEATS are done.
+ * The repeats run in batches of THREADS, each on a worker Simulation with
+ * its own random stream, and the workers are merged in at the end.
+ */
+void Simulation::repeatToPrecision()
+{
+	int threads = std::max(1, params.threads);
+	int max_repeats = std::max(params.repeats, params.max_repeats);
+	std::vector< std::unique_ptr<Simulation> > workers;
+	for(int t=0;t<threads;t++)
+		workers.push_back(std::unique_ptr<Simulation>(new Simulation(this)));
+	
+	//the threads are started once and shared by every sweep point, every batch runs on them
+	if(!replication_threads || replication_threads->size() != threads)
+		replication_threads.reset(new WorkerPool(threads));
+	
+	int done = 0;
+	while(done < max_repeats)
+	{
+		if(done >= std::max(params.repeats, 2)
+			&& delay_runs.getHalfWidth() <= params.precision * fabs(delay_runs.getMean())
+			&& pdr_runs.getHalfWidth() <= params.precision * fabs(pdr_runs.getMean()))
+			break;
+		
+		int batch = std::min(threads, max_repeats - done);
+		replication_threads->run(batch, [&](int t){ workers[t]->replicate(done + t); });
+		
+		//in order of the replications, so the stopping point does not depend on the threads
+		for(int t=0;t<batch;t++,done++)
+		{
+			total_delay+=workers[t]->run_delay;
+			total_pdr+=workers[t]->run_pdr;
+			delay_runs.add(workers[t]->run_delay);
+			pdr_runs.add(workers[t]->run_pdr);
+			repeat_delays.push_back(workers[t]->run_delay);
+			repeat_pdrs.push_back(workers[t]->run_pdr);
+			if(params.warmup && workers[t]->state.warmup.hasTruncation())
+				steady_runs.add(workers[t]->state.warmup.getMean());
+		}
+	}
+	
+	for(int t=0;t<threads;t++)
+		merge(*workers[t]);
+	current_run = done + 1;
+}
+
+/*
+ * Runs the given replication (from 0) of a worker
+ */
+void Simulation::replicate(int replication)
+{
+	seedReplication(base_seed, replication);
+	current_run = replication + 1;
+	(this->*selectRun())();
+}
+
+/*
+ * Adds the totals of a worker, apart from the delay and PDR of each
+ * repeat, which repeatToPrecision() collects as they finish
+ */
+void Simulation::merge(const Simulation &worker)
+{
+	total_drop_delay+=worker.total_drop_delay;
+	total_dropped+=worker.total_dropped;
+	total_schedules+=worker.total_schedules;
+	total_budget_hits+=worker.total_budget_hits;
+	total_search_saved+=worker.total_search_saved;
+	total_gap+=worker.total_gap;
+	total_events+=worker.total_events;
+	total_schedule_seconds+=worker.total_schedule_seconds;
+	if(worker.total_peak_queue > total_peak_queue)
+		total_peak_queue = worker.total_peak_queue;
+	profile.merge(worker.profile);
+	counters.merge(worker.counters);
+	delays.merge(worker.delays);
+}
+
+/*
+ * Returns the run loop compiled for the scheduling and instrumentation
+ * policies the scenario asks for (mixed-bias only applies with FS)
+ */
+Simulation::RunFunction Simulation::selectRun()
+{
+	static const RunFunction runs[3][4] = {
+		{&Simulation::run<NoScheduling, SilentTrace>, &Simulation::run<NoScheduling, DebugTrace>, &Simulation::run<NoScheduling, ProfileTrace>, &Simulation::run<NoScheduling, RecordTrace>},
+		{&Simulation::run<FairScheduling, SilentTrace>, &Simulation::run<FairScheduling, DebugTrace>, &Simulation::run<FairScheduling, ProfileTrace>, &Simulation::run<FairScheduling, RecordTrace>},
+		{&Simulation::run<MixedBiasScheduling, SilentTrace>, &Simulation::run<MixedBiasScheduling, DebugTrace>, &Simulation::run<MixedBiasScheduling, ProfileTrace>, &Simulation::run<MixedBiasScheduling, RecordTrace>}
+	};
+	
+	int scheduling = 0;
+	if(params.fs_enabled)
+		scheduling = params.mb_enabled ? 2 : 1;
+	int trace = 0;
+	if(params.debugging)
+		trace = 1;
+	else if(EventTrace::enabled())
+		trace = 3;
+	else if(params.profile_events)
+		trace = 2;
+	return runs[scheduling][trace];
+}
+
 /*
  * Executes a Simulation Run
  */
+template <class Scheduling, class Trace>
 void Simulation::run()
 {
 	//std::cout << "  Executing Run: " << current_run << std::endl;
+	Timeline::Span span("replication", current_run);
+	
+	const std::vector<MeshRouter> &MR = topology->getMR();
 	
 	//initialize statistics for this run
 	now = 0;
 	initializeTopology();
-	double delay = 0;
-	int packet_counter = 0;
-	int success_packets = 0;
-	int dropped_packets = 0;
+	state.run = Trace::beginRun();
 	
 	Event E;
 	E = generatePacket();
-	EQ.push(E);
+	state.EQ.push(E);
 	std::vector<Clique> scheduling;
 	
-	while(!EQ.empty() && now < END && packet_counter < NUMPACKETS)
+	//the dispatch counters run from here to the end, except during SCHEDULE events
+	PerfSample dispatch_started = counters.sample();
+	
+	while(!state.EQ.empty() && now < params.end && state.packet_counter < params.num_packets && !state.warmup.isSteady())
 	{
-		E = EQ.top(); EQ.pop();
+		if((unsigned int)state.EQ.size() > state.peak_queue)
+			state.peak_queue = (unsigned int)state.EQ.size();
+		E = state.EQ.top(); state.EQ.pop();
+		state.events++;
 		
 		//get information from event
 		double time = E.getTime();
@@ -164,7 +358,7 @@ void Simulation::run()
 		int source = E.getSource();
 		int destination = E.getDestination();
 		int type = E.getType();
-		int neighbour = -1;
+		int packet;
 		now = time;
 		
 		//variables for updating requirement tables
@@ -175,30 +369,22 @@ void Simulation::run()
 		int x,y, weight;
 		double start_schedule, stop_schedule;
 		
+		unsigned long long handler_started = Trace::startEvent();
 		switch(type)
 		{
 			case NEW:
-				//std::cout << "    New Event, t=" << now << " MC: " << source << " (" << MC[source].getX() << "," << MC[source].getY() << ")" << " MR: " << destination << " (" << MR[destination].getX() << "," << MR[destination].getY() << ")" << std::endl;
-				//MR[destination].display();
-				//pause();
+				Trace::newPacket(source, destination, now);
 				
-				//ensure that the MR buffer is empty
-				if(MR[destination].getBuffer() == -1)
+				//ensure that the MR queue has room
+				if(!state.queues.full(destination))
 				{
-					packet_counter++;
-					MR[destination].setBuffer(MCPACKET);
+					state.packet_counter++;
 					
-					//check if we already have success
-					if(MR[destination].isGW())
-						E = Event(SUCCESS, destination, MCPACKET, now, start_time);
-					else
+					//update requirement table
+					current_gw = MR[destination].getNearestGW();
+					if(Scheduling::enabled)
 					{
-						neighbour = getNeighbour(destination);
-						E = Event(HOP, destination, neighbour, now + getDelay(), start_time);
-						
-						//update requirement table
 						current_router = destination;
-						current_gw = MR[destination].getNearestGW();
 						while(current_router != current_gw)
 						{
 							addRequirement(current_router);
@@ -206,104 +392,134 @@ void Simulation::run()
 						}
 					}
 					
-					EQ.push(E);
+					//a packet which arrives at a GW has already succeeded
+					packet = state.packets.allocate(state.packet_counter, destination, current_gw, start_time);
+					Trace::record(state.run, NEW, now, destination, current_gw, state.packet_counter, now - start_time);
+					enqueue(destination, packet, MR[destination].isGW());
 					
 					//if this is the first packet, we must initiate a scheduling
-					if(packet_counter == 1 && fs_enabled)
+					if(Scheduling::enabled && state.packet_counter == 1)
 					{
 						E = Event(SCHEDULE, -1, -1, now, now);
-						EQ.push(E);
+						state.EQ.push(E);
 					}
 				}
 				else
 				{
+					Trace::record(state.run, NEW, now, destination, -1, -1, now - start_time);
 					//E = Event(DROP, MCPACKET, -1, now, start_time);
 					//EQ.push(E);	
 				} //drop for now if collision between MC and MR
 			break;
 			case HOP:
-				//std::cout << "    Hop Event, t=" << now << " From MR: " << source << " to MR: " << destination << std::endl;
-				//MR[source].display();
-				//MR[destination].display();
-				//pause();
+				Trace::hop(source, destination, now);
+				Trace::record(state.run, HOP, now, source, destination, state.packets[state.queues.front(source)].id, now - start_time);
 				
-				//ensure buffer is empty
-				if(MR[destination].getBuffer() == -1)
+				//ensure queue has room
+				if(!state.queues.full(destination))
 				{
-					//ensure that we have permission to send (always do with fs_enabled = 0)
-					if(MR[destination].hasPermission())
+					//ensure that we have permission to send (always do without FS)
+					if(state.permission[destination])
 					{
-						MR[destination].setBuffer(source);
-						MR[source].setBuffer(-1);
+						packet = state.queues.pop(source);
+						state.packets[packet].hops++;
 					
 						//update requirement table
-						if(source!=MCPACKET)
+						if(Scheduling::enabled && source!=MCPACKET)
 							removeRequirement(source);
-											
-						//check to see if we have arrived
-						if(MR[destination].isGW())
-							E = Event(SUCCESS, destination, -1, now + getDelay(), start_time);
-						//hop if we havent'
-						else
-						{
-							neighbour = getNeighbour(destination);
-							E = Event(HOP, destination, neighbour, now + getDelay(), start_time);
-						}
+						
+						//the destination sends it on (or delivers it) once it reaches the front
+						enqueue(destination, packet, false);
+						
+						//move on to the next packet waiting at the source
+						if(!state.queues.empty(source))
+							startSending(source, false);
+						break;
 					}
 					else
 					{
 						/***** NEED TO CHANGE THIS TO ONLY RETRY IF NOW - STARTIME < RETRY THRESHOLD ************/
-						//std::cout << "No Permission to send packet" << std::endl;
-						if(now - start_time < HOPDELAY)
+						Trace::noPermission(source, destination, now);
+						
+						//wait for the destination to be given permission instead of polling
+						if(params.wait_lists)
+						{
+							state.waiting.park(destination, E, now);
+							
+							//give up at the deadline if it is still parked then (see the DROP case)
+							if(params.max_wait_time > 0)
+								state.EQ.push(Event(DROP, source, destination, now + params.max_wait_time, now));
+							break;
+						}
+						
+						if(now - start_time < params.hop_delay)
 							E = Event(HOP, source, destination, now + getDelay(), start_time); //retry
 						else
 							E = Event(DROP, source, -1, now, start_time);
 					}
 				}
-				//drop packet if buffer not available
+				//drop packet if queue is full
 				else
 				{
 					E = Event(DROP, source, -1, now, start_time);
 				}
 				
-				EQ.push(E);
+				state.EQ.push(E);
 			break;
 			case DROP:
-				//std::cout << "    Drop Event, t=" << now << " at MR: " << source << std::endl;
-				//pause();
+				//a DROP with a destination is the deadline of a packet parked there, started at the time it was parked
+				if(destination != -1)
+				{
+					Event parked;
+					if(!state.waiting.expire(destination, source, start_time, parked))
+						break;
+					start_time = parked.getStartTime();
+				}
+				Trace::drop(source, now);
 				
-				dropped_packets++;
-				delay += now - start_time;
+				state.dropped_packets++;
+				state.drop_delay += now - start_time;
 				if(source != MCPACKET)
 				{
-					MR[source].setBuffer(-1);
-				
 					//update requirement table
-					current_router = source;
-					current_gw = MR[source].getNearestGW();
-					while(current_router != current_gw)
+					if(Scheduling::enabled)
 					{
-						removeRequirement(current_router);
-						current_router = getNeighbour(current_router);
+						current_router = source;
+						current_gw = MR[source].getNearestGW();
+						while(current_router != current_gw)
+						{
+							removeRequirement(current_router);
+							current_router = getNeighbour(current_router);
+						}
 					}
+					
+					Packet finished = finishSending(source);
+					delays.drop(finished.destination, finished.hops);
+					Trace::record(state.run, DROP, now, source, finished.destination, finished.id, now - start_time);
 				}
 			break;
 			case SUCCESS:
-				//std::cout << "    Success Event, t=" << now << " at MR: " << source << std::endl;
-				//pause();
+				Trace::success(source, now);
 				
-				success_packets++;
-				delay += now - start_time;
+				state.success_packets++;
+				state.delay += now - start_time;
 				if(source != MCPACKET)
-					MR[source].setBuffer(-1);
+				{
+					Packet finished = finishSending(source);
+					delays.success(now - start_time, finished.destination, finished.hops);
+					Trace::record(state.run, SUCCESS, now, source, finished.destination, finished.id, now - start_time);
+					if(params.warmup)
+						state.warmup.add(now - start_time, now);
+				}
 			break;
 			case SCHEDULE:
-				//std::cout << "    Schedule Event, t=" << now << std::endl;
-				//pause();
-				
-				//std::cout << "packets: " << packet_counter << " now: " << now << std::endl;
-				
-				scheduling = generateSchedule();
+			{
+				std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now();
+				PerfSample schedule_started = counters.sample();
+				counters.add(PERF_DISPATCH, dispatch_started, schedule_started);
+				scheduling = Scheduling::generate(*this);
+				Trace::schedule(scheduling.size(), now);
+				Trace::record(state.run, SCHEDULE, now, -1, -1, -1, 0);
 				
 				start_schedule = now;
 				
@@ -312,59 +528,95 @@ void Simulation::run()
 				{
 					//scheduling[x].display();
 					weight = scheduling[x].getWeight();
-					stop_schedule = start_schedule + weight * getDelay();
+					stop_schedule = start_schedule + weight * getRoundLength();
 					
 					//create the start and stop events for each link in the current schedule round
 					for(y=0;y<(int)scheduling[x].links.size();y++)
 					{
 						source=scheduling[x].links[y].first;
 						E = Event(P_START, source, -1, start_schedule, now);
-						EQ.push(E);
+						state.EQ.push(E);
 						E = Event(P_STOP, source, -1, stop_schedule, now);
-						EQ.push(E);
+						state.EQ.push(E);
 						
 						destination=scheduling[x].links[y].second;
 						E = Event(P_START, destination, -1, start_schedule, now);	
-						EQ.push(E);
+						state.EQ.push(E);
 						E = Event(P_STOP, destination, -1, stop_schedule, now);	
-						EQ.push(E);
+						state.EQ.push(E);
 					}
 					
 					start_schedule = stop_schedule;
 				}
-				E = Event(SCHEDULE, -1, -1, start_schedule + getDelay(), now);
-				EQ.push(E);
+				E = Event(SCHEDULE, -1, -1, start_schedule + getRoundLength(), now);
+				state.EQ.push(E);
+				state.schedule_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+				dispatch_started = counters.sample();
+				counters.add(PERF_SCHEDULING, schedule_started, dispatch_started);
 				//displayMRs();
 				//pause();
+			}
 			break;
 			case P_START:
-				//std::cout << "    Start Permission Event, t=" << now << " at MR: " << source << std::endl;
-				//pause();
-				MR[source].setPermission(true);
+				Trace::permissionStart(source, now);
+				Trace::record(state.run, P_START, now, source, -1, -1, 0);
+				state.permission[source] = true;
+				if(params.wait_lists)
+					wakeParked(source);
 			break;
 			case P_STOP:
-				//std::cout << "    Stop Permission Event, t=" << now << " at MR: " << source << std::endl;
-				//pause();
-				MR[source].setPermission(false);
+				Trace::permissionStop(source, now);
+				Trace::record(state.run, P_STOP, now, source, -1, -1, 0);
+				state.permission[source] = false;
 			break;
 			default:
 				std::cout << "Error, unrecognized Event. Simulation ending. " << std::endl;
 				exit(255);
 		}
-		E = generatePacket();
-		EQ.push(E);
+		Trace::endEvent(profile, type, handler_started);
+		
+		//with CRN only a NEW event draws the next arrival, so the arrivals do not depend on how many other events a configuration handles
+		if(!params.crn || type == NEW)
+		{
+			E = generatePacket();
+			state.EQ.push(E);
+		}
 	}
+	counters.add(PERF_DISPATCH, dispatch_started, counters.sample());
 	
-	//display statistics for this run
+	//display statistics for this run, the delay is that of the delivered packets only
 	double average_delay = 0;
 	double pdr = 0;
-	if(success_packets > 0)
-		average_delay = delay / (double)success_packets;
-	if(packet_counter > 0)
-		pdr = success_packets / (double)packet_counter;
+	if(state.success_packets > 0)
+		average_delay = state.delay / (double)state.success_packets;
+	if(state.packet_counter > 0)
+		pdr = state.success_packets / (double)state.packet_counter;
 	
+	//a repeat too short for MSER-5 has no steady-state delay
+	if(params.warmup)
+	{
+		state.warmup.update();
+		if(state.warmup.hasTruncation())
+			steady_runs.add(state.warmup.getMean());
+	}
+	run_delay = average_delay;
+	run_pdr = pdr;
 	total_delay+=average_delay;
 	total_pdr+=pdr;
+	total_drop_delay+=state.drop_delay;
+	total_dropped+=state.dropped_packets;
+	delay_runs.add(average_delay);
+	pdr_runs.add(pdr);
+	repeat_delays.push_back(average_delay);
+	repeat_pdrs.push_back(pdr);
+	total_schedules+=state.schedule_counter;
+	total_budget_hits+=state.budget_hits;
+	total_search_saved+=state.search_saved;
+	total_gap+=state.schedule_gap;
+	total_events+=state.events;
+	total_schedule_seconds+=state.schedule_seconds;
+	if(state.peak_queue > total_peak_queue)
+		total_peak_queue = state.peak_queue;
 
 	//std::cout << "    Packets Generated: " << packet_counter << " Success: " << success_packets << " Dropped: " << dropped_packets << std::endl;
 	//std::cout << "    Average Delay: " << average_delay << " PDR: " << pdr << std::endl;
@@ -385,6 +637,7 @@ void Simulation::pause()
 void Simulation::displayMRs()
 {
 	std::cout << "  Displaying Mesh Routers: " << std::endl;
+	const std::vector<MeshRouter> &MR = topology->getMR();
 	for(int x=0; x<(int)MR.size();x++)
 		MR[x].display();
 }
@@ -395,6 +648,7 @@ void Simulation::displayMRs()
 void Simulation::displayMCs()
 {
 	std::cout << "  Displaying Mesh Clients: " << std::endl;
+	const std::vector<MeshClient> &MC = topology->getMC();
 	for(int x=0; x<(int)MC.size();x++)
 		MC[x].display();
 }
@@ -402,36 +656,30 @@ void Simulation::displayMCs()
 void Simulation::displayLSs()
 {
 	std::cout << "  Displaying Links: " << std::endl;
+	const std::vector<Link> &LS = topology->getLS();
 	for(int x=0; x<(int)LS.size();x++)
 		LS[x].display();
 }
 
 /*
- * Ensures all buffers are empty, requirements cleared etc
+ * Ensures the events and queues are empty, requirements and statistics
+ * cleared etc, keeping the memory of the previous run
  */
 void Simulation::initializeTopology()
 {
-	for(int c=0; c<(int)MR.size();c++)
-	{
-		MR[c].setBuffer(-1);
-		if(fs_enabled)
-			MR[c].setPermission(false);
-		else
-			MR[c].setPermission(true);
-	}
-	
-	for(int c=0; c<(int)LS.size();c++)
-		LS[c].requirement = 0;
+	state.reset(topology->getMR().size(), topology->getLS().size(), !params.fs_enabled, params.queue_capacity);
+	state.warmup.reset(params.steady_precision);
 }
 
 /*
- * Generates a new packet with mean inter-arrival time MEAN
+ * Generates a new packet with the mean inter-arrival time of the scenario
  */
 Event Simulation::generatePacket()
 {
 	double time;
-	time = now + (-MEAN * log(drand48()));
-	int source = (int)(drand48() * MC.size());
+	time = now + (-params.mean * log(arrivalUniform()));
+	const std::vector<MeshClient> &MC = topology->getMC();
+	int source = (int)(arrivalUniform() * MC.size());
 	int destination = MC[source].getMR();
 	
 	return Event(NEW, source, destination, time, time);
@@ -442,11 +690,9 @@ Event Simulation::generatePacket()
  */
 int Simulation::getNeighbour(int router)
 {
-	for(int x=0;x<(int)LS.size();x++)
-	{
-		if(LS[x].first == router)
-			return LS[x].second;
-	}
+	int next_hop = topology->getNextHop(router);
+	if(next_hop != -1)
+		return next_hop;
 	
 	std::cout << "Error, could not find the next-hop neighbour for router: " << router << ". Serious error." << std::endl;
 	exit(255);
@@ -457,13 +703,11 @@ int Simulation::getNeighbour(int router)
  */
 void Simulation::addRequirement(int router)
 {
-	for(int x=0;x<(int)LS.size();x++)
+	int link = topology->getLink(router);
+	if(link != -1)
 	{
-		if(LS[x].first == router)
-		{
-			LS[x].requirement++;
-			return;
-		}	
+		state.requirement[link]++;
+		return;
 	}
 	std::cout << "Error, could not find the router: " << router << " for incrementing requiremnt. Serious error." << std::endl;
 	exit(255);
@@ -474,34 +718,169 @@ void Simulation::addRequirement(int router)
  */
 void Simulation::removeRequirement(int router)
 {
-	for(int x=0;x<(int)LS.size();x++)
+	int link = topology->getLink(router);
+	if(link != -1)
 	{
-		if(LS[x].first == router)
-		{
-			LS[x].requirement--;
-			return;
-		}	
+		state.requirement[link]--;
+		return;
 	}
 	std::cout << "Error, could not find the router: " << router << " for removing requiremnt. Serious error." << std::endl;
 	exit(255);
 }
 
 /*
- * Generates a link scheduling based on the requirements at each link in the network
+ * Generates a link scheduling based on the requirements at each link in the network.
+ * With mixed_bias the cliques are ranked by the biased scores of their links
+ * rather than the raw requirements, the rounds still last as long as the largest requirement.
  */
-std::vector <Clique> Simulation::generateSchedule()
+std::vector <Clique> Simulation::generateSchedule(bool mixed_bias)
 {
+	Timeline::Span span("schedule");
+	std::vector <Link> active = getActiveLinks(mixed_bias);
+	std::vector <Clique> schedule;
+	if(params.scheduler == DSATUR_SCHEDULER || params.scheduler == LRF_SCHEDULER)
+		schedule = generateColoringSchedule(active, params.scheduler == DSATUR_SCHEDULER, mixed_bias);
+	else if(params.scheduler != CLIQUE_SCHEDULER)
+	{
+		std::cout << "Error, unknown SCHEDULER: " << params.scheduler << std::endl;
+		exit(255);
+	}
+	else if(params.schedule_ops > 0 || params.schedule_time > 0)
+		schedule = generateBudgetedSchedule(active, mixed_bias);
+	else
+	{
+		ScheduleBudget unlimited;
+		schedule = selectCliques(generateAllCliques(active, unlimited), mixed_bias);
+	}
+	
+	if(params.local_search > 0)
+		improveSchedule(schedule);
+	return schedule;
+}
+
+/*
+ * Shortens the schedule with at most LOCAL_SEARCH moves and swaps of links
+ * between its rounds (see LocalSearch.h)
+ */
+void Simulation::improveSchedule(std::vector <Clique> &schedule)
+{
+	Timeline::Span span("local search");
+	std::vector <Link> links;
+	for(int c=0;c<(int)schedule.size();c++)
+		links.insert(links.end(), schedule[c].links.begin(), schedule[c].links.end());
+	
+	LocalSearch pass;
+	state.search_saved += pass.improve(schedule, getConflicts(links), params.local_search);
+}
+
+/*
+ * Builds a schedule within SCHEDULE_OPS/SCHEDULE_TIME: a DSATUR schedule
+ * to start with, then the clique scheduling for as long as the budget lasts,
+ * keeping whichever is shorter. Records whether the budget ran out and how far
+ * the result is from the lower bound.
+ */
+std::vector <Clique> Simulation::generateBudgetedSchedule(const std::vector <Link> &active, bool mixed_bias)
+{
+	int bound = getLowerBound(active);
+	if(bound == 0)
+		return std::vector <Clique>();
+	
+	ScheduleBudget budget(params.schedule_ops, params.schedule_time);
+	std::vector <Clique> schedule = generateColoringSchedule(active, true, mixed_bias);
+	std::vector <Clique> improved = selectCliques(generateAllCliques(active, budget), mixed_bias);
+	
+	int length = getLength(schedule);
+	if(getLength(improved) < length)
+	{
+		schedule.swap(improved);
+		length = getLength(schedule);
+	}
+	
+	state.schedule_counter++;
+	if(budget.cutShort())
+		state.budget_hits++;
+	state.schedule_gap += (length - bound) / (double)bound;
+	return schedule;
+}
+
+/*
+ * Returns a schedule made by colouring the conflict graph of the active links
+ * (see Coloring.h), which takes polynomial rather than exponential time
+ */
+std::vector <Clique> Simulation::generateColoringSchedule(const std::vector <Link> &active, bool dsatur, bool mixed_bias)
+{
+	std::vector < std::vector <int> > conflicts = getConflicts(active);
+	Timeline::Span span("colouring");
+	Coloring engine(active, conflicts, dsatur, mixed_bias);
+	return engine.generate();
+}
+
+/*
+ * Returns the conflict graph of the links: for each link, the indices of the links it interferes with
+ */
+std::vector < std::vector <int> > Simulation::getConflicts(const std::vector <Link> &links)
+{
+	Timeline::Span span("compatibility");
+	std::vector < std::vector <int> > conflicts(links.size());
+	for(int x=0;x<(int)links.size();x++)
+	{
+		for(int y=x+1;y<(int)links.size();y++)
+		{
+			if(interfere(links[x], links[y]))
+			{
+				conflicts[x].push_back(y);
+				conflicts[y].push_back(x);
+			}
+		}
+	}
+	return conflicts;
+}
+
+/*
+ * Returns how many hop delays a schedule takes, the sum of the clique weights
+ */
+int Simulation::getLength(const std::vector <Clique> &schedule)
+{
+	int length = 0;
+	for(int x=0;x<(int)schedule.size();x++)
+		length += schedule[x].getWeight();
+	return length;
+}
+
+/*
+ * Returns a lower bound on the length of any schedule for the links. Links
+ * sharing an MR always interfere, so the busiest MR needs the sum of its requirements.
+ */
+int Simulation::getLowerBound(const std::vector <Link> &active)
+{
+	std::vector <int> load(topology->getMR().size(), 0);
+	int bound = 0;
+	for(int x=0;x<(int)active.size();x++)
+	{
+		load[active[x].first] += active[x].requirement;
+		load[active[x].second] += active[x].requirement;
+		bound = std::max(bound, std::max(load[active[x].first], load[active[x].second]));
+	}
+	return bound;
+}
+
+/*
+ * Greedily picks the clique with the largest gain (see generateSchedule)
+ * until every clique has been picked or intersects one which was
+ */
+std::vector <Clique> Simulation::selectCliques(std::vector <Clique> allCliques, bool mixed_bias)
+{
+	Timeline::Span span("clique selection");
 	std::vector <Clique> schedule;
-	std::vector <Clique> allCliques = generateAllCliques();
 	//std::cout << "Generating scheduling..." << std::endl;
 
 	//continue generating the schedule while there are still cliques left
 	while(allCliques.size() > 0)
 	{
-		int max_gain=-1; int max_index=-1; int gain=0;
+		double max_gain=-1; int max_index=-1; double gain=0;
 		for(int x=0;x<(int)allCliques.size();x++)
 		{
-			gain = allCliques[x].getGain();
+			gain = mixed_bias ? allCliques[x].getBiasedGain() : allCliques[x].getGain();
 			if(gain > max_gain)
 			{
 				max_gain = gain;
@@ -529,57 +908,84 @@ std::vector <Clique> Simulation::generateSchedule()
 	return schedule;
 }
 
+/*
+ * Copies out only the links which need scheduling, along with their
+ * requirement (and mixed-bias score)
+ */
+std::vector <Link> Simulation::getActiveLinks(bool mixed_bias)
+{
+	Timeline::Span span("active links");
+	const std::vector<Link> &LS = topology->getLS();
+	std::vector <Link> active;
+	for(int x=0; x<(int)LS.size();x++)
+	{
+		if(state.requirement[x] > 0)
+		{
+			active.push_back(LS[x]);
+			active.back().requirement = state.requirement[x];
+			if(mixed_bias)
+				active.back().bias = bias.score(state.requirement[x], topology->getMR()[LS[x].first].getHops());
+		}
+	}
+	return active;
+}
+
 /*
  * Generates all combinations of links which are compatible with each other
- * (links which can transmit together without interference)
+ * (links which can transmit together without interference). Once the budget
+ * runs out no more are generated, but every link still gets a single link clique.
  */
-std::vector <Clique> Simulation::generateAllCliques()
+std::vector <Clique> Simulation::generateAllCliques(const std::vector <Link> &active, ScheduleBudget &budget)
 {
+	Timeline::Span span("clique enumeration");
 	//std::cout << "Generating All Cliques..." << std::endl;
 	std::vector <Clique> allCliques;
-	for(int x=0; x<(int)LS.size();x++)
+	
+	for(int x=0; x<(int)active.size() && budget.spend(active.size() + allCliques.size());x++)
 	{
 		Clique c;
+		c.links.push_back(active[x]);
 		
-		if(LS[x].requirement > 0)
+		for(int y=0; y<(int)active.size();y++)
 		{
-			c.links.push_back(LS[x]);
-						
-			for(int y=0; y<(int)LS.size();y++)
+			if(y!=x && compatibleLink(active[y], c))
 			{
-				if(LS[y].requirement > 0 && y!=x && compatibleLink(LS[y], c))
-				{
-					c.links.push_back(LS[y]);
-				}
+				c.links.push_back(active[y]);
 			}
+		}
 		
-			if(unique(allCliques,c))
+		if(unique(allCliques,c))
+		{
+			//std::cout << "Adding cliques starting with link: " << x << " out of total: " << LS.size() << std::endl;
+			//c.display();
+			allCliques.push_back(c);
+			
+			//decomposing makes every subset, so a clique too large for the operation limit is left whole (the decomposition also stops once the budget runs out)
+			long subsets = 1L << std::min((int)c.links.size(), 62);
+			if(!budget.affords(subsets))
 			{
-				//std::cout << "Adding cliques starting with link: " << x << " out of total: " << LS.size() << std::endl;
-				//c.display();
-				allCliques.push_back(c);
-				std::vector <Clique> smallerCliques = c.decompose();
-				for(int y=0;y<(int)smallerCliques.size();y++)
-				{
-					if(unique(allCliques, smallerCliques[y]))
-						allCliques.push_back(smallerCliques[y]);
-				}
+				budget.skip();
+				continue;
+			}
+			
+			std::vector <Clique> smallerCliques = c.decompose(budget);
+			for(int y=0;y<(int)smallerCliques.size() && budget.spend(allCliques.size());y++)
+			{
+				if(unique(allCliques, smallerCliques[y]))
+					allCliques.push_back(smallerCliques[y]);
 			}
 		}
 	}
 	
 	/* push on single linked cliques so none which have a requirement are missed
 	 */
-	for(int x=0;x<(int)LS.size();x++)
+	for(int x=0;x<(int)active.size();x++)
 	{
-		if(LS[x].requirement>0)
-		{
-			//push on the single linked cliques
-			Clique small;
-			small.links.push_back(LS[x]);
-			if(unique(allCliques, small))
-				allCliques.push_back(small);
-		}
+		//push on the single linked cliques
+		Clique small;
+		small.links.push_back(active[x]);
+		if(unique(allCliques, small))
+			allCliques.push_back(small);
 	}
 	
 	//std::cout << "done." << std::endl;
@@ -593,7 +999,7 @@ std::vector <Clique> Simulation::generateAllCliques()
 /*
  * Returns true if the given clique is unique when compared to the vector of cliques
  */
-bool Simulation::unique(std::vector <Clique> cliques, Clique c)
+bool Simulation::unique(const std::vector <Clique> &cliques, const Clique &c)
 {
 	//prevent empty cliques
 	if(c.links.size() == 0)
@@ -610,7 +1016,7 @@ bool Simulation::unique(std::vector <Clique> cliques, Clique c)
 /*
  * Returns true if the given link is compatible with the existing links within a Clique
  */
-bool Simulation::compatibleLink(Link l, Clique c)
+bool Simulation::compatibleLink(const Link &l, const Clique &c)
 {
 	for(int x=0;x<(int)c.links.size();x++)
 	{
@@ -623,7 +1029,7 @@ bool Simulation::compatibleLink(Link l, Clique c)
 /*
  * Returns true if the two links interfere with one another
  */
-bool Simulation::interfere(Link l1, Link l2)
+bool Simulation::interfere(const Link &l1, const Link &l2)
 {
 	if(l1.first == l2.first || l1.first == l2.second || l2.first == l1.second || l2.second == l1.second)
 		return true;
@@ -634,7 +1040,7 @@ bool Simulation::interfere(Link l1, Link l2)
 		int d1 = l1.second;
 		int d2 = l2.second;
 		
-		if(distance(s1,s2) < RANGE || distance(s1, d2) < RANGE || distance(s2, d1) < RANGE)
+		if(topology->distance(s1,s2) < params.range || topology->distance(s1, d2) < params.range || topology->distance(s2, d1) < params.range)
 			return true;	
 		else
 			return false;	
@@ -642,23 +1048,82 @@ bool Simulation::interfere(Link l1, Link l2)
 }
 
 /*
- * Returns the distance between two 2d points p1, p2
+ * Retries every HOP parked on the router now that it has permission.
+ * With MAX_WAIT_TIME the packets which waited too long have already been
+ * dropped at their deadlines.
+ */
+void Simulation::wakeParked(int router)
+{
+	Event parked;
+	double parked_at;
+	
+	while(state.waiting.wake(router, parked, parked_at))
+		state.EQ.push(Event(HOP, parked.getSource(), parked.getDestination(), now, parked.getStartTime()));
+}
+
+/*
+ * Adds a packet to the router's queue, and starts sending it straight
+ * away if the router was idle. With QUEUE_PRIORITY the packets which have
+ * been in the network longest are sent first.
+ */
+void Simulation::enqueue(int router, int packet, bool immediate)
+{
+	if(params.queue_priority)
+		state.queues.push(router, packet, state.packets[packet].start_time);
+	else
+		state.queues.push(router, packet);
+	
+	if(state.queues.size(router) == 1)
+		startSending(router, immediate);
+}
+
+/*
+ * Schedules the next event for the packet at the front of the router's
+ * queue: SUCCESS at a GW, otherwise a HOP towards the GW. Unless
+ * immediate, it happens after a random hop delay.
  */
-double Simulation::distance(int source, int destination)
+void Simulation::startSending(int router, bool immediate)
 {
-	double p1x = MR[source].getX();
-	double p2x = MR[destination].getX();
-	double p1y = MR[source].getY();
-	double p2y = MR[destination].getY();
+	const Packet &p = state.packets[state.queues.front(router)];
 	
-	return sqrt((p2x-p1x)*(p2x-p1x) + (p2y-p1y)*(p2y-p1y));
+	if(topology->getMR()[router].isGW())
+		state.EQ.push(Event(SUCCESS, router, -1, immediate ? now : now + getDelay(), p.start_time));
+	else
+	{
+		int neighbour = getNeighbour(router);
+		state.EQ.push(Event(HOP, router, neighbour, immediate ? now : now + getDelay(), p.start_time));
+	}
+}
+
+/*
+ * Removes the packet at the front of the router's queue once it has been
+ * delivered or dropped, starts on the next one and returns the finished
+ * packet's record
+ */
+Packet Simulation::finishSending(int router)
+{
+	int packet = state.queues.pop(router);
+	Packet finished = state.packets[packet];
+	state.packets.release(packet);
+	if(!state.queues.empty(router))
+		startSending(router, false);
+	return finished;
 }
 
 /*
- * Returns a random delay between 0 and HOPDELAY
+ * Returns a random delay with mean hop_delay
  */
 double Simulation::getDelay()
 {
-	return (-HOPDELAY * log(drand48()));
+	return (-params.hop_delay * log(delayUniform()));
+}
+
+/*
+ * Returns a random schedule round length with mean hop_delay, drawn from
+ * its own stream so scheduling does not shift the hop delays
+ */
+double Simulation::getRoundLength()
+{
+	return (-params.hop_delay * log(scheduleUniform()));
 }
 #endif
@@ -5,86 +5,139 @@
 #include "MeshClient.h"
 #include "Link.h"
 #include "TopologyHelper.h"
+#include "Topology.h"
+#include "RunState.h"
+#include "Parameters.h"
+#include "Policies.h"
 #include "Event.h"
 #include "Clique.h"
+#include "BiasTable.h"
+#include "ScheduleBudget.h"
+#include "Coloring.h"
+#include "LocalSearch.h"
+#include "EventProfile.h"
+#include "Timeline.h"
+#include "PerfCounters.h"
+#include "StreamStats.h"
+#include "WorkerPool.h"
 
-/* Simulation Parameters */
-#define REPEATS						10		//how many times we should repeat for consistent results
-#define START							0.0		//start time (s)
-#define END								300.0	//end time (s)
-#define NUMPACKETS				10000	//number of packets
-#define MEAN							0.01		//mean inter-arrival time
-#define HOPDELAY					0.01		//the maximum average delay for each hop
-#define MAX_X							1000	//maximum x dimension of the simulation environment in meters
-#define MAX_Y							1000	//maximum y dimension of the simulation environment in meters
-#define NUM_MC						250   //the number of MCs in the simulation
-#define RANGE							250		//maximum communication range of MRs and MCs in meters
-
-/* Mixed-Bias Parameters */
-#define A1								0.2		//alpha 1 -> proportion to use b11 bias (1-a1) uses b12
-#define B11								5			//strong bias exponent against greedy flows
-#define B12								1     //weak bias exponent against greedy flows (proportional fair component when b12=1)
-
-#define A2								0.2		//alpha 2 -> proportion to use b21 bias (1-a2) uses b22
-#define B21								5			//strong bias exponent against many hops
-#define B22								1			//weak bias exponent against many hops
-
-#define G									0.5		//gamma -> what proportion of resources to assign to each strategy
-
-/* Simulation Options */
-#define DEBUGGING					1			//toggle debug on/off
-#define DISPLAY_PROGRESS	1			//toggle display % complete on/off
+/*
+ * The simulation parameters (repeats, times, dimensions, mixed-bias
+ * weights etc.) are read at runtime, see Parameters.h
+ */
  
 #include <iostream>
-#include <queue>
+#include <memory>
+#include <cstdlib>
 
 class Simulation
 {
 	public:
-		Simulation(int _num_mr, int _num_gw, int _num_mc, bool _fs_enabled, bool _mb_enabled);
+		Simulation(int _num_mr, int _num_gw, const Parameters &_params);
+		Simulation(std::shared_ptr<const Topology> _topology, const Parameters &_params);
 		void pause();
+		
+		//totals over every repeat
+		double getAverageDelay(){return total_delay / delay_runs.getCount();};
+		double getAveragePDR(){return total_pdr / pdr_runs.getCount();};
+		double getAverageDropDelay(){return total_dropped > 0 ? total_drop_delay / total_dropped : 0;};
+		long getEvents(){return total_events;};
+		unsigned int getPeakQueue(){return total_peak_queue;};
+		double getScheduleSeconds(){return total_schedule_seconds;};
+		const std::vector<double> &getRepeatDelays(){return repeat_delays;};
+		const std::vector<double> &getRepeatPDRs(){return repeat_pdrs;};
+		
+		static void stopReplicationThreads();
 	private:
+		Simulation(const Simulation *parent);
+		
 		void displayMRs();
 		void displayMCs();
 		void displayLSs();
+		void initialize(const Parameters &_params);
 		void initializeTopology();
+		void resetStatistics();
 		void start();
-		void run();
+		void repeatToPrecision();
+		void replicate(int replication);
+		void merge(const Simulation &worker);
+		
+		//the run loop is a template over a scheduling and an instrumentation policy (see Policies.h)
+		typedef void (Simulation::*RunFunction)();
+		RunFunction selectRun();
+		template <class Scheduling, class Trace> void run();
+		
+		//random numbers, every Simulation has its own streams
+		void seedReplication(long base, int replication);
+		double arrivalUniform(){return erand48(arrival_state);};
+		double delayUniform(){return erand48(delay_state);};
+		double scheduleUniform(){return erand48(schedule_state);};
 		
 		//simulation event functions
 		Event generatePacket();
 		int getNeighbour(int router);
 		double getDelay();
+		double getRoundLength();
+		void wakeParked(int router);
+		void enqueue(int router, int packet, bool immediate);
+		void startSending(int router, bool immediate);
+		Packet finishSending(int router);
 		
 		//schedule generation functions
+		friend struct FairScheduling;
+		friend struct MixedBiasScheduling;
 		void addRequirement(int router);
 		void removeRequirement(int router);
-		std::vector <Clique> generateSchedule();
-		std::vector <Clique> generateAllCliques();
-		bool unique(std::vector <Clique> cliques, Clique c);
-		bool interfere(Link l1, Link l2);
-		double distance(int source, int destination);
-		bool compatibleLink(Link l, Clique c);
+		std::vector <Clique> generateSchedule(bool mixed_bias);
+		std::vector <Clique> generateBudgetedSchedule(const std::vector <Link> &active, bool mixed_bias);
+		std::vector <Clique> generateColoringSchedule(const std::vector <Link> &active, bool dsatur, bool mixed_bias);
+		void improveSchedule(std::vector <Clique> &schedule);
+		std::vector < std::vector <int> > getConflicts(const std::vector <Link> &links);
+		std::vector <Clique> selectCliques(std::vector <Clique> allCliques, bool mixed_bias);
+		std::vector <Clique> generateAllCliques(const std::vector <Link> &active, ScheduleBudget &budget);
+		std::vector <Link> getActiveLinks(bool mixed_bias);
+		int getLength(const std::vector <Clique> &schedule);
+		int getLowerBound(const std::vector <Link> &active);
+		bool unique(const std::vector <Clique> &cliques, const Clique &c);
+		bool interfere(const Link &l1, const Link &l2);
+		bool compatibleLink(const Link &l, const Clique &c);
 		
 		
-		//important topology information
-		std::vector <MeshRouter> MR;
-		std::vector <MeshClient> MC;
-		std::vector <MeshRouter> GW;
-		std::vector <Link> LS;
-		TopologyHelper topology;
+		//important topology information (shared, read-only)
+		std::shared_ptr<const Topology> topology;
 		
-		//event queue
-		std::priority_queue<Event> EQ;
+		//events, queues, permissions, requirements and statistics of the current run
+		RunState state;
 		
 		//important simulation variables
 		int num_gw, num_mr, num_mc, current_run;
 		double now;
-		bool fs_enabled, mb_enabled;
+		Parameters params;
+		BiasTable bias;
+		long base_seed;
+		unsigned short arrival_state[3];	//erand48 states, see seedReplication()
+		unsigned short delay_state[3];
+		unsigned short schedule_state[3];
 		
 		//statistics variables
 		double total_delay;
 		double total_pdr;
+		double total_drop_delay;			//age of every dropped packet, kept apart from the delivered delay
+		long total_dropped;
+		double run_delay, run_pdr;			//of the last repeat
+		int total_schedules, total_budget_hits, total_search_saved;
+		double total_gap;
+		long total_events;
+		unsigned int total_peak_queue;
+		double total_schedule_seconds;
+		EventProfile profile;		//over every repeat, filled only by the ProfileTrace policy
+		PerfCounters counters;		//over every repeat
+		DelayStats delays;			//of every packet delivered and dropped over the repeats
+		RunningStat delay_runs, pdr_runs;	//the average delay and PDR of each repeat, for the confidence intervals
+		RunningStat steady_runs;			//the delay of each repeat after its warm-up, with WARMUP (only the repeats long enough for MSER-5)
+		std::vector<double> repeat_delays, repeat_pdrs;	//of every repeat in order, for the paired differences with CRN
+		
+		static std::unique_ptr<WorkerPool> replication_threads;	//threads for the repeats with PRECISION, shared by every Simulation
 };
 
 #endif
@@ -0,0 +1,42 @@
+#ifndef TIMELINE_H
+#define TIMELINE_H
+
+#include <string>
+#include <atomic>
+
+#define TIMELINE_CAPACITY 65536		//spans kept per thread, the oldest are overwritten
+
+/*
+ * Records begin/end spans of the simulator phases (topology generation,
+ * each SCHEDULE and its parts, replications, sweep jobs) and writes them
+ * as Chrome trace JSON at exit, for chrome://tracing or Perfetto. Every
+ * thread records into its own ring buffer, so recording takes no lock.
+ * Nothing is recorded until open() is called (TRACE_FILE=path).
+ */
+class Timeline
+{
+	public:
+		static void open(const std::string &path);
+		static bool enabled() { return active.load(std::memory_order_relaxed); }
+		static long long now();
+		static void record(const char *name, long arg, long long begin, long long end);
+		static void dump();
+		
+		//records the span from its construction to its destruction
+		class Span
+		{
+			public:
+				Span(const char *_name, long _arg = -1) : name(_name), arg(_arg), begin(enabled() ? now() : 0) {}
+				~Span() { if(enabled()) record(name, arg, begin, now()); }
+			
+			private:
+				const char *name;
+				long arg;
+				long long begin;
+		};
+	
+	private:
+		static std::atomic<bool> active;
+};
+
+#endif
@@ -0,0 +1,85 @@
+#ifndef TOPOLOGY_CC
+#define TOPOLOGY_CC
+
+#include "Topology.h"
+#include "Timeline.h"
+
+/*
+ * Generates a new topology with the TopologyHelper and keeps the result
+ */
+Topology::Topology(int _max_x, int _max_y, int _num_mr, int _num_gw, int _num_mc, double _range)
+{
+	Timeline::Span span("topology");
+	TopologyHelper helper(_max_x, _max_y, _num_mr, _num_gw, _num_mc, _range);
+	MR = helper.getMR();
+	GW = helper.getGW();
+	MC = helper.getMC();
+	LS = helper.getLS();
+	
+	generateRoutes();
+}
+
+/*
+ * Accessor Functions to return the MRs, GWs, MCs and Links
+ */
+const std::vector<MeshRouter> &Topology::getMR() const
+{	return MR; }
+const std::vector<MeshRouter> &Topology::getGW() const
+{	return GW; }
+const std::vector<MeshClient> &Topology::getMC() const
+{	return MC; }
+const std::vector<Link> &Topology::getLS() const
+{	return LS; }
+
+/*
+ * Returns the next hop on the way to the gateway for a given router
+ * (-1 if the router has no outgoing link)
+ */
+int Topology::getNextHop(int router) const
+{
+	return next_hop[router];
+}
+
+/*
+ * Returns the index of the link with the given router as the "source"
+ * (-1 if the router has no outgoing link)
+ */
+int Topology::getLink(int router) const
+{
+	return link_index[router];
+}
+
+/*
+ * Returns the distance between two MRs
+ */
+double Topology::distance(int source, int destination) const
+{
+	double p1x = MR[source].getX();
+	double p2x = MR[destination].getX();
+	double p1y = MR[source].getY();
+	double p2y = MR[destination].getY();
+	
+	return sqrt((p2x-p1x)*(p2x-p1x) + (p2y-p1y)*(p2y-p1y));
+}
+
+/*
+ * Each router routes over the first link which has it as the "source",
+ * so the next hop is resolved once here instead of searching LS per packet
+ */
+void Topology::generateRoutes()
+{
+	next_hop.assign(MR.size(), -1);
+	link_index.assign(MR.size(), -1);
+	
+	for(int x=0;x<(int)LS.size();x++)
+	{
+		int router = LS[x].first;
+		if(link_index[router] == -1)
+		{
+			next_hop[router] = LS[x].second;
+			link_index[router] = x;
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef TOPOLOGY_H
+#define TOPOLOGY_H
+
+#include <vector>
+
+#include "MeshRouter.h"
+#include "MeshClient.h"
+#include "Link.h"
+#include "TopologyHelper.h"
+
+/*
+ * Read-only snapshot of a generated topology: router and client positions,
+ * the links on each router's path to its GW and the resulting routes.
+ * It never changes once built, so every replication and every sweep job
+ * at the same point can share one instance through a shared_ptr.
+ */
+class Topology
+{
+	public:
+		Topology(int _max_x, int _max_y, int _num_mr, int _num_gw, int _num_mc, double _range);
+		
+		const std::vector<MeshRouter> &getMR() const;
+		const std::vector<MeshRouter> &getGW() const;
+		const std::vector<MeshClient> &getMC() const;
+		const std::vector<Link> &getLS() const;
+		
+		int getNextHop(int router) const;
+		int getLink(int router) const;
+		double distance(int source, int destination) const;
+	
+	private:
+		void generateRoutes();
+		
+		std::vector<MeshRouter> MR;
+		std::vector<MeshRouter> GW;
+		std::vector<MeshClient> MC;
+		std::vector<Link> LS;
+		
+		//routes: next hop towards the GW and the link used to get there (-1 at a GW)
+		std::vector<int> next_hop;
+		std::vector<int> link_index;
+};
+
+#endif
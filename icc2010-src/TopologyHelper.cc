@@ -35,13 +35,13 @@ TopologyHelper::TopologyHelper()
 /*
  * Accessor Functions to return the MRs, GWs and MCs
  */
-std::vector<MeshRouter> TopologyHelper::getMR()
+const std::vector<MeshRouter> &TopologyHelper::getMR() const
 {	return MR; }
-std::vector<MeshRouter> TopologyHelper::getGW()
+const std::vector<MeshRouter> &TopologyHelper::getGW() const
 {	return GW; }
-std::vector<MeshClient> TopologyHelper::getMC()
+const std::vector<MeshClient> &TopologyHelper::getMC() const
 {	return MC; }
-std::vector<Link> TopologyHelper::getLS()
+const std::vector<Link> &TopologyHelper::getLS() const
 { return LS; }
 
 /*
@@ -197,82 +197,76 @@ void TopologyHelper::addLink(Link temp)
  */
 void TopologyHelper::positionGWs()
 {
+	//no GWs placed yet, so every MR is infinitely far from one
+	gw_distance.assign(MR.size(), std::numeric_limits<double>::max());
+	gw_nearest.assign(MR.size(), -1);
+	
 	//automatically assign the middle mesh router as a gateway to start
 	int middle_mr = (MR.size()-1) / 2;
-	MR[middle_mr].setGW();
-	GW.push_back(MR[middle_mr]);
+	addGW(middle_mr);
 	
 	//keep selecting gateways while we still need more
 	while((int)GW.size() < num_gw)
-	{
-		int next_gw = getNextGW();
-		MR[next_gw].setGW();
-		GW.push_back(MR[next_gw]);
-	}
+		addGW(getNextGW());
 	
-	//associate each MR with its closest GW
+	//associate each MR with its closest GW (already tracked by addGW)
 	for(int c=0;c<(int)MR.size();c++)
 	{
-		int nearest_gw = nearestGW(c);
-		int hops = distance(MR[c].getX(), MR[nearest_gw].getX(), MR[c].getY(), MR[nearest_gw].getY()) / range;
+		int hops = gw_distance[c] / range;
 		MR[c].setHops(hops);
-		MR[c].setNearestGW(nearest_gw);
+		MR[c].setNearestGW(gw_nearest[c]);
 	}
 }
 
 /*
- * This will select the best MR for another GW given the GWs that
- * already exist by maximizing the minimum distance from all GWs
+ * Makes the given MR a GW and updates the distance from every MR to
+ * its nearest GW in a single pass, so placing num_gw gateways costs
+ * O(MR * GW) instead of recomputing all the nearest GWs each time
  */
-int TopologyHelper::getNextGW()
+void TopologyHelper::addGW(int mr)
 {
-	double min_distance = 0;
-	int min_index = -1;
+	MR[mr].setGW();
+	GW.push_back(MR[mr]);
 	
+	double gw_x = MR[mr].getX();
+	double gw_y = MR[mr].getY();
 	for(int c=0; c<(int)MR.size(); c++)
 	{
-		int nearest_gw = nearestGW(c);
-		double current_distance = distance(MR[c].getX(), MR[nearest_gw].getX(), MR[c].getY(), MR[nearest_gw].getY());
-		if(current_distance > min_distance)
+		//strictly closer only, so ties stay with the GW placed first
+		double current_distance = distance(MR[c].getX(), gw_x, MR[c].getY(), gw_y);
+		if(current_distance < gw_distance[c])
 		{
-			min_distance = current_distance;
-			min_index = c;
+			gw_distance[c] = current_distance;
+			gw_nearest[c] = mr;
 		}
 	}
-	
-	if(min_index == -1)
-	{
-		std::cout << "Error, could not choose the next best GW, serious problems." << std::endl;
-		exit(255);
-	}
-	
-	return min_index;
 }
 
 /*
- * Returns the nearest GW to a given MR
+ * This will select the best MR for another GW given the GWs that
+ * already exist by maximizing the minimum distance from all GWs
  */
-int TopologyHelper::nearestGW(int mr)
+int TopologyHelper::getNextGW()
 {
-	double min_distance = std::numeric_limits<double>::max();
+	double min_distance = 0;
 	int min_index = -1;
-	for(int c=0; c<(int)GW.size();c++)
+	
+	for(int c=0; c<(int)MR.size(); c++)
 	{
-		double current_distance = distance(MR[mr].getX(), GW[c].getX(), MR[mr].getY(), GW[c].getY());
-		if(current_distance < min_distance)
+		if(gw_distance[c] > min_distance)
 		{
+			min_distance = gw_distance[c];
 			min_index = c;
-			min_distance = current_distance;
 		}
 	}
 	
 	if(min_index == -1)
 	{
-		std::cout << "Error, could not find a nearest GW, serious problems." << std::endl;
+		std::cout << "Error, could not choose the next best GW, serious problems." << std::endl;
 		exit(255);
 	}
 	
-	return GW[min_index].getId();
+	return min_index;
 }
 
 /*
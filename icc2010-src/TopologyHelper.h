@@ -15,10 +15,10 @@ class TopologyHelper
 		TopologyHelper();
 		TopologyHelper(int _max_x, int _max_y, int _num_mr, int _num_gw, int _num_mc, double _range);
 		
-		std::vector<MeshRouter> getMR();
-		std::vector<MeshRouter> getGW();
-		std::vector<MeshClient> getMC();
-		std::vector<Link> getLS();
+		const std::vector<MeshRouter> &getMR() const;
+		const std::vector<MeshRouter> &getGW() const;
+		const std::vector<MeshClient> &getMC() const;
+		const std::vector<Link> &getLS() const;
 	
 	private:
 		void generateTopology();
@@ -27,8 +27,8 @@ class TopologyHelper
 		void positionGWs();
 		void addLink(Link temp);
 		
+		void addGW(int mr);
 		int getNextGW();
-		int nearestGW(int mr);
 		int nearestMR(double x, double y);
 		int nearestNeighbour(int router, int gateway);
 		double distance(double p1x, double p2x, double p1y, double p2y);
@@ -39,6 +39,10 @@ class TopologyHelper
 		std::vector<MeshRouter> GW;
 		std::vector<MeshClient> MC;
 		std::vector<Link> LS;
+		
+		//distance from each MR to its nearest GW so far (used while placing GWs)
+		std::vector<double> gw_distance;
+		std::vector<int> gw_nearest;
 };
 
 #endif
@@ -0,0 +1,94 @@
+/*
+ * Reads a binary event trace written with EVENT_TRACE=path and prints,
+ * for every run, how many events of each type it handled and the mean
+ * delay of the packets delivered and dropped. With "print" every record
+ * is printed instead, one per line.
+ *
+ * usage: ./wmn-tracedump trace [print]
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "Event.h"
+#include "TraceReader.h"
+
+#define EVENT_TYPES 7
+
+static const char *type_names[EVENT_TYPES] = {"NEW", "HOP", "DROP", "SUCCESS", "SCHEDULE", "P_START", "P_STOP"};
+
+//what one run of the trace added up to
+struct RunSummary
+{
+	RunSummary() { for(int t=0;t<EVENT_TYPES;t++) events[t] = 0; success_delay = 0; drop_delay = 0; end = 0; }
+	long events[EVENT_TYPES];
+	double success_delay, drop_delay;
+	double end;
+};
+
+static void print(const TraceReader &trace)
+{
+	std::cout << "run\ttime\ttype\tsource\tdestination\tpacket\tdelay" << std::endl;
+	for(const TraceRecord *r = trace.begin(); r != trace.end(); r++)
+	{
+		const char *name = (r->type() >= 0 && r->type() < EVENT_TYPES) ? type_names[r->type()] : "?";
+		std::cout << r->run() << "\t" << r->time << "\t" << name << "\t" << r->source << "\t" << r->destination << "\t" << r->packet << "\t" << r->delay << std::endl;
+	}
+}
+
+static void summarise(const TraceReader &trace)
+{
+	std::vector<RunSummary> runs;
+	for(const TraceRecord *r = trace.begin(); r != trace.end(); r++)
+	{
+		if(r->type() < 0 || r->type() >= EVENT_TYPES)
+			continue;
+		if(r->run() >= (int)runs.size())
+			runs.resize(r->run() + 1);
+		
+		RunSummary &run = runs[r->run()];
+		run.events[r->type()]++;
+		if(r->type() == SUCCESS)
+			run.success_delay += r->delay;
+		else if(r->type() == DROP)
+			run.drop_delay += r->delay;
+		if(r->time > run.end)
+			run.end = r->time;
+	}
+	
+	std::cout << "Records: " << trace.size() << "\tRuns: " << runs.size() << std::endl;
+	for(unsigned int r=0;r<runs.size();r++)
+	{
+		const RunSummary &run = runs[r];
+		std::cout << "Run " << r << "\tEnd: " << run.end;
+		for(int t=0;t<EVENT_TYPES;t++)
+			std::cout << "\t" << type_names[t] << ": " << run.events[t];
+		std::cout << std::endl;
+		
+		if(run.events[SUCCESS] > 0)
+			std::cout << "  Average Delivered Delay: " << run.success_delay / run.events[SUCCESS];
+		if(run.events[DROP] > 0)
+			std::cout << "  Average Dropped Delay: " << run.drop_delay / run.events[DROP];
+		std::cout << std::endl;
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	if(argc < 2)
+	{
+		std::cout << "usage: " << argv[0] << " trace [print]" << std::endl;
+		return 255;
+	}
+	
+	TraceReader trace;
+	if(!trace.open(argv[1]))
+		return 255;
+	
+	if(argc > 2 && std::string(argv[2]) == "print")
+		print(trace);
+	else
+		summarise(trace);
+	return 0;
+}
@@ -0,0 +1,112 @@
+#ifndef WAITLIST_CC
+#define WAITLIST_CC
+
+#include "WaitList.h"
+
+/*
+ * Empties all of the lists and makes room for num_routers of them
+ */
+void WaitList::resize(int num_routers)
+{
+	nodes.clear();
+	head.assign(num_routers, -1);
+	tail.assign(num_routers, -1);
+	free_nodes = -1;
+	parked = 0;
+}
+
+/*
+ * Parks the event at the end of the router's list
+ */
+void WaitList::park(int router, const Event &E, double time)
+{
+	int n;
+	if(free_nodes != -1)
+	{
+		n = free_nodes;
+		free_nodes = nodes[n].next;
+	}
+	else
+	{
+		n = nodes.size();
+		nodes.push_back(Node());
+	}
+	
+	nodes[n].event = E;
+	nodes[n].time = time;
+	nodes[n].next = -1;
+	
+	if(tail[router] == -1)
+		head[router] = n;
+	else
+		nodes[tail[router]].next = n;
+	tail[router] = n;
+	parked++;
+}
+
+/*
+ * Removes the first event parked on the router, returning it and the
+ * time it was parked. Returns false if nothing is waiting there.
+ */
+bool WaitList::wake(int router, Event &E, double &time)
+{
+	int n = head[router];
+	if(n == -1)
+		return false;
+	
+	E = nodes[n].event;
+	time = nodes[n].time;
+	
+	head[router] = nodes[n].next;
+	if(head[router] == -1)
+		tail[router] = -1;
+	
+	nodes[n].next = free_nodes;
+	free_nodes = n;
+	parked--;
+	return true;
+}
+
+/*
+ * Removes the event the source parked on the router at the given time,
+ * returning it. Returns false if it has already been woken.
+ */
+bool WaitList::expire(int router, int source, double time, Event &E)
+{
+	int previous = -1;
+	int n = head[router];
+	while(n != -1 && !(nodes[n].event.getSource() == source && nodes[n].time == time))
+	{
+		previous = n;
+		n = nodes[n].next;
+	}
+	if(n == -1)
+		return false;
+	
+	E = nodes[n].event;
+	if(previous == -1)
+		head[router] = nodes[n].next;
+	else
+		nodes[previous].next = nodes[n].next;
+	if(tail[router] == n)
+		tail[router] = previous;
+	
+	nodes[n].next = free_nodes;
+	free_nodes = n;
+	parked--;
+	return true;
+}
+
+/*
+ * Returns true if nothing is parked on the router
+ */
+bool WaitList::empty(int router) const
+{ return head[router] == -1; }
+
+/*
+ * Returns the number of packets parked on all routers
+ */
+int WaitList::size() const
+{ return parked; }
+
+#endif
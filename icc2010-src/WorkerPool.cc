@@ -0,0 +1,86 @@
+#ifndef WORKERPOOL_CC
+#define WORKERPOOL_CC
+
+#include "WorkerPool.h"
+
+/*
+ * Starts threads-1 helper threads, the caller of run() being the other
+ */
+WorkerPool::WorkerPool(int threads)
+{
+	current = NULL;
+	count = 0;
+	pending = 0;
+	batches = 0;
+	stopping = false;
+	for(int t=1;t<threads;t++)
+		helpers.push_back(std::thread(&WorkerPool::work, this, t));
+}
+
+WorkerPool::~WorkerPool()
+{
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		stopping = true;
+	}
+	started.notify_all();
+	for(unsigned int t=0;t<helpers.size();t++)
+		helpers[t].join();
+}
+
+/*
+ * Runs job(0) to job(jobs-1) at once, job(t) on thread t, and returns
+ * when they have all finished. jobs must not be more than the threads.
+ */
+void WorkerPool::run(int jobs, const std::function<void(int)> &job)
+{
+	if(jobs <= 1 || helpers.empty())
+	{
+		for(int t=0;t<jobs;t++)
+			job(t);
+		return;
+	}
+	
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		current = &job;
+		count = jobs;
+		pending = jobs - 1;
+		batches++;
+	}
+	started.notify_all();
+	
+	job(0);
+	
+	std::unique_lock<std::mutex> guard(lock);
+	finished.wait(guard, [this]{ return pending == 0; });
+	current = NULL;
+}
+
+/*
+ * Helper thread index: runs its job of every batch large enough to have one
+ */
+void WorkerPool::work(int index)
+{
+	long seen = 0;
+	std::unique_lock<std::mutex> guard(lock);
+	while(true)
+	{
+		started.wait(guard, [&]{ return batches != seen || stopping; });
+		if(stopping)
+			return;
+		seen = batches;
+		if(index >= count)
+			continue;
+		
+		const std::function<void(int)> &job = *current;
+		guard.unlock();
+		job(index);
+		guard.lock();
+		
+		if(--pending == 0)
+			finished.notify_one();
+	}
+}
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef WORKERPOOL_H
+#define WORKERPOOL_H
+
+#include <vector>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+/*
+ * A fixed set of threads for running batches of replications. The helper
+ * threads are started once and wait between batches, so every batch runs
+ * on the same threads (and the same Timeline buffers) rather than new ones.
+ * The calling thread takes job 0 of each batch itself.
+ */
+class WorkerPool
+{
+	public:
+		WorkerPool(int threads);
+		~WorkerPool();
+		
+		void run(int jobs, const std::function<void(int)> &job);
+		int size() const { return helpers.size() + 1; }
+	
+	private:
+		WorkerPool(const WorkerPool &);
+		WorkerPool &operator=(const WorkerPool &);
+		
+		void work(int index);
+		
+		std::vector<std::thread> helpers;
+		std::mutex lock;
+		std::condition_variable started, finished;
+		const std::function<void(int)> *current;
+		int count;			//jobs in the current batch
+		int pending;		//helpers still running a job of the current batch
+		long batches;		//batches started, so the helpers can tell a new one
+		bool stopping;
+};
+
+#endif